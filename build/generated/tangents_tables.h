@@ -0,0 +1,572 @@
+/*
+Constant tables of the Tangents DSP, generated by tools/gentables.cpp
+(make builds and runs it). Do not edit; change the generator.
+*/
+
+#ifndef TANGENTS_TABLES_H
+#define TANGENTS_TABLES_H
+
+// g = tan(pi r) at r = i / PREWARP_TABLE_RESOLUTION, up to 0.45 and one beyond
+static const float PREWARP_TABLE_RESOLUTION = 4096.0f;
+static const int PREWARP_TABLE_ENTRIES = 1845;
+
+static const float prewarpTable[1845] = {
+	0.0f, 0.000766990532f, 0.00153398199f, 0.00230097515f, 0.00306797121f, 0.00383497076f,
+	0.00460197497f, 0.0053689843f, 0.00613600016f, 0.00690302299f, 0.00767005421f, 0.00843709428f,
+	0.00920414459f, 0.00997120515f, 0.0107382778f, 0.0115053635f, 0.0122724622f, 0.0130395759f,
+	0.0138067044f, 0.0145738488f, 0.0153410109f, 0.0161081906f, 0.01687539f, 0.0176426098f,
+	0.0184098482f, 0.0191771109f, 0.019944394f, 0.0207117014f, 0.0214790329f, 0.0222463906f,
+	0.0230137743f, 0.0237811841f, 0.0245486218f, 0.0253160894f, 0.0260835867f, 0.0268511139f,
+	0.0276186727f, 0.028386265f, 0.0291538909f, 0.0299215503f, 0.0306892451f, 0.0314569771f,
+	0.0322247446f, 0.0329925492f, 0.0337603949f, 0.0345282778f, 0.0352962054f, 0.0360641703f,
+	0.0368321799f, 0.0376002342f, 0.0383683294f, 0.0391364731f, 0.0399046615f, 0.0406728983f,
+	0.0414411798f, 0.0422095135f, 0.0429778956f, 0.0437463261f, 0.0445148125f, 0.0452833474f,
+	0.0460519381f, 0.046820581f, 0.0475892797f, 0.0483580381f, 0.0491268486f, 0.0498957187f,
+	0.0506646484f, 0.0514336377f, 0.0522026904f, 0.0529717989f, 0.0537409745f, 0.0545102134f,
+	0.055279512f, 0.0560488813f, 0.0568183139f, 0.0575878136f, 0.0583573803f, 0.0591270179f,
+	0.0598967262f, 0.0606665015f, 0.0614363514f, 0.0622062758f, 0.0629762709f, 0.0637463406f,
+	0.0645164847f, 0.0652867034f, 0.066057004f, 0.0668273792f, 0.0675978363f, 0.0683683679f,
+	0.0691389889f, 0.0699096844f, 0.0706804618f, 0.0714513287f, 0.0722222775f, 0.0729933083f,
+	0.0737644285f, 0.0745356381f, 0.0753069371f, 0.0760783181f, 0.0768497959f, 0.0776213631f,
+	0.0783930197f, 0.0791647658f, 0.0799366161f, 0.0807085484f, 0.081480585f, 0.0822527185f,
+	0.0830249414f, 0.0837972686f, 0.0845697001f, 0.085342221f, 0.0861148536f, 0.0868875831f,
+	0.0876604095f, 0.0884333476f, 0.0892063901f, 0.0899795368f, 0.0907527879f, 0.0915261507f,
+	0.0922996253f, 0.0930732042f, 0.0938468948f, 0.0946206897f, 0.0953946039f, 0.0961686373f,
+	0.096942775f, 0.0977170318f, 0.0984914005f, 0.0992658958f, 0.100040503f, 0.100815229f,
+	0.101590075f, 0.102365039f, 0.103140131f, 0.103915341f, 0.104690671f, 0.105466135f,
+	0.106241718f, 0.107017428f, 0.107793264f, 0.108569235f, 0.109345332f, 0.110121556f,
+	0.110897914f, 0.111674398f, 0.112451024f, 0.113227777f, 0.114004672f, 0.1147817f,
+	0.115558863f, 0.116336167f, 0.117113605f, 0.117891185f, 0.118668906f, 0.119446769f,
+	0.120224774f, 0.12100292f, 0.121781215f, 0.122559652f, 0.123338237f, 0.124116965f,
+	0.124895848f, 0.125674874f, 0.126454055f, 0.127233386f, 0.128012866f, 0.128792509f,
+	0.129572302f, 0.130352244f, 0.131132349f, 0.131912604f, 0.132693022f, 0.13347359f,
+	0.134254321f, 0.135035217f, 0.135816276f, 0.136597499f, 0.137378886f, 0.138160437f,
+	0.138942137f, 0.139724031f, 0.140506074f, 0.141288295f, 0.142070681f, 0.14285323f,
+	0.143635958f, 0.144418865f, 0.145201936f, 0.145985186f, 0.146768615f, 0.147552207f,
+	0.148335993f, 0.149119943f, 0.149904072f, 0.150688395f, 0.151472896f, 0.152257577f,
+	0.153042436f, 0.153827488f, 0.15461272f, 0.15539813f, 0.156183735f, 0.156969532f,
+	0.157755524f, 0.158541694f, 0.159328058f, 0.160114616f, 0.160901368f, 0.161688313f,
+	0.162475452f, 0.163262784f, 0.164050311f, 0.164838046f, 0.165625975f, 0.166414112f,
+	0.167202443f, 0.167990968f, 0.168779716f, 0.169568658f, 0.170357794f, 0.171147153f,
+	0.171936721f, 0.172726482f, 0.173516467f, 0.174306646f, 0.175097048f, 0.175887659f,
+	0.176678479f, 0.177469522f, 0.178260773f, 0.179052249f, 0.179843932f, 0.18063584f,
+	0.181427971f, 0.182220325f, 0.183012888f, 0.183805674f, 0.184598699f, 0.185391933f,
+	0.186185405f, 0.186979085f, 0.187773004f, 0.188567162f, 0.189361542f, 0.190156147f,
+	0.19095099f, 0.191746056f, 0.192541361f, 0.193336904f, 0.194132686f, 0.194928706f,
+	0.195724949f, 0.196521446f, 0.197318181f, 0.198115155f, 0.198912367f, 0.199709833f,
+	0.200507537f, 0.201305479f, 0.202103674f, 0.202902123f, 0.203700811f, 0.204499751f,
+	0.205298945f, 0.206098378f, 0.206898078f, 0.207698032f, 0.20849824f, 0.2092987f,
+	0.210099414f, 0.210900396f, 0.211701617f, 0.21250312f, 0.213304877f, 0.214106902f,
+	0.214909181f, 0.215711728f, 0.216514543f, 0.217317611f, 0.218120962f, 0.218924582f,
+	0.21972847f, 0.220532626f, 0.22133705f, 0.222141758f, 0.222946733f, 0.223751977f,
+	0.224557504f, 0.225363314f, 0.226169392f, 0.226975769f, 0.227782413f, 0.228589341f,
+	0.229396537f, 0.230204031f, 0.231011823f, 0.231819883f, 0.232628241f, 0.233436882f,
+	0.234245807f, 0.235055029f, 0.235864535f, 0.236674353f, 0.237484455f, 0.23829484f,
+	0.239105538f, 0.239916518f, 0.240727812f, 0.241539404f, 0.242351294f, 0.243163481f,
+	0.243975967f, 0.244788766f, 0.245601878f, 0.246415287f, 0.247228995f, 0.248043016f,
+	0.248857364f, 0.249671996f, 0.25048697f, 0.251302242f, 0.252117813f, 0.252933711f,
+	0.253749937f, 0.254566461f, 0.255383313f, 0.256200492f, 0.257018f, 0.257835805f,
+	0.258653939f, 0.25947243f, 0.260291219f, 0.261110336f, 0.26192978f, 0.262749553f,
+	0.263569653f, 0.264390111f, 0.265210867f, 0.266031981f, 0.266853422f, 0.267675191f,
+	0.268497318f, 0.269319773f, 0.270142555f, 0.270965695f, 0.271789163f, 0.272612989f,
+	0.273437142f, 0.274261653f, 0.275086522f, 0.275911719f, 0.276737273f, 0.277563184f,
+	0.278389424f, 0.279216051f, 0.280043006f, 0.280870318f, 0.281697989f, 0.282526016f,
+	0.283354431f, 0.284183174f, 0.285012275f, 0.285841763f, 0.286671609f, 0.287501812f,
+	0.288332373f, 0.289163321f, 0.289994627f, 0.290826291f, 0.291658342f, 0.29249078f,
+	0.293323576f, 0.29415673f, 0.294990271f, 0.2958242f, 0.296658516f, 0.29749319f,
+	0.298328251f, 0.299163699f, 0.299999505f, 0.300835729f, 0.301672339f, 0.302509308f,
+	0.303346694f, 0.304184437f, 0.305022597f, 0.305861145f, 0.306700081f, 0.307539433f,
+	0.308379143f, 0.309219271f, 0.310059816f, 0.310900748f, 0.311742067f, 0.312583804f,
+	0.313425928f, 0.31426847f, 0.315111399f, 0.315954775f, 0.316798538f, 0.317642689f,
+	0.318487287f, 0.319332272f, 0.320177674f, 0.321023524f, 0.321869761f, 0.322716415f,
+	0.323563486f, 0.324411005f, 0.325258911f, 0.326107264f, 0.326956034f, 0.327805221f,
+	0.328654855f, 0.329504907f, 0.330355376f, 0.331206292f, 0.332057625f, 0.332909405f,
+	0.333761632f, 0.334614277f, 0.335467368f, 0.336320877f, 0.337174863f, 0.338029265f,
+	0.338884115f, 0.339739412f, 0.340595156f, 0.341451347f, 0.342307985f, 0.34316507f,
+	0.344022602f, 0.344880581f, 0.345739037f, 0.34659794f, 0.34745729f, 0.348317116f,
+	0.34917739f, 0.350038111f, 0.350899309f, 0.351760983f, 0.352623105f, 0.353485703f,
+	0.354348779f, 0.355212301f, 0.3560763f, 0.356940776f, 0.357805729f, 0.358671129f,
+	0.359537035f, 0.360403419f, 0.361270279f, 0.362137616f, 0.36300543f, 0.36387372f,
+	0.364742517f, 0.365611792f, 0.366481543f, 0.3673518f, 0.368222535f, 0.369093776f,
+	0.369965494f, 0.370837718f, 0.37171042f, 0.372583628f, 0.373457342f, 0.374331564f,
+	0.375206292f, 0.376081496f, 0.376957208f, 0.377833456f, 0.378710181f, 0.379587442f,
+	0.380465209f, 0.381343484f, 0.382222265f, 0.383101553f, 0.383981377f, 0.384861708f,
+	0.385742575f, 0.386623949f, 0.387505829f, 0.388388276f, 0.38927123f, 0.39015469f,
+	0.391038716f, 0.391923249f, 0.392808318f, 0.393693924f, 0.394580066f, 0.395466715f,
+	0.39635393f, 0.397241682f, 0.39812997f, 0.399018824f, 0.399908185f, 0.400798112f,
+	0.401688606f, 0.402579606f, 0.403471202f, 0.404363304f, 0.405256003f, 0.406149238f,
+	0.40704301f, 0.407937378f, 0.408832282f, 0.409727752f, 0.410623759f, 0.411520362f,
+	0.412417531f, 0.413315266f, 0.414213568f, 0.415112436f, 0.41601187f, 0.4169119f,
+	0.417812496f, 0.418713659f, 0.419615418f, 0.420517743f, 0.421420664f, 0.422324151f,
+	0.423228234f, 0.424132913f, 0.425038159f, 0.425944f, 0.426850438f, 0.427757472f,
+	0.428665102f, 0.429573327f, 0.430482149f, 0.431391597f, 0.432301611f, 0.43321225f,
+	0.434123486f, 0.435035318f, 0.435947776f, 0.43686083f, 0.437774509f, 0.438688815f,
+	0.439603716f, 0.440519243f, 0.441435367f, 0.442352116f, 0.443269521f, 0.444187522f,
+	0.445106149f, 0.446025401f, 0.44694531f, 0.447865814f, 0.448786974f, 0.44970876f,
+	0.450631201f, 0.451554239f, 0.452477962f, 0.453402281f, 0.454327285f, 0.455252916f,
+	0.456179172f, 0.457106113f, 0.458033681f, 0.458961904f, 0.459890783f, 0.460820317f,
+	0.461750507f, 0.462681383f, 0.463612884f, 0.464545071f, 0.465477914f, 0.466411412f,
+	0.467345595f, 0.468280435f, 0.469215959f, 0.47015214f, 0.471089005f, 0.472026557f,
+	0.472964764f, 0.473903686f, 0.474843264f, 0.475783527f, 0.476724505f, 0.47766614f,
+	0.478608489f, 0.479551494f, 0.480495214f, 0.48143965f, 0.482384771f, 0.483330578f,
+	0.484277099f, 0.485224307f, 0.486172229f, 0.487120867f, 0.48807022f, 0.489020258f,
+	0.489971042f, 0.490922511f, 0.491874725f, 0.492827624f, 0.493781269f, 0.494735628f,
+	0.495690703f, 0.496646523f, 0.497603059f, 0.498560339f, 0.499518335f, 0.500477076f,
+	0.501436532f, 0.502396762f, 0.503357708f, 0.50431937f, 0.505281806f, 0.506245017f,
+	0.507208943f, 0.508173645f, 0.509139061f, 0.510105252f, 0.511072218f, 0.5120399f,
+	0.513008356f, 0.513977587f, 0.514947593f, 0.515918314f, 0.51688987f, 0.517862141f,
+	0.518835247f, 0.519809067f, 0.520783722f, 0.521759093f, 0.522735298f, 0.523712218f,
+	0.524689972f, 0.525668502f, 0.526647866f, 0.527627945f, 0.528608859f, 0.529590607f,
+	0.53057307f, 0.531556427f, 0.5325405f, 0.533525407f, 0.534511149f, 0.535497665f,
+	0.536485016f, 0.537473142f, 0.538462102f, 0.539451897f, 0.540442467f, 0.54143393f,
+	0.542426169f, 0.543419242f, 0.544413149f, 0.545407891f, 0.546403408f, 0.547399819f,
+	0.548397064f, 0.549395144f, 0.550394058f, 0.551393807f, 0.55239445f, 0.553395867f,
+	0.554398179f, 0.555401325f, 0.556405365f, 0.55741024f, 0.558415949f, 0.559422553f,
+	0.56042999f, 0.561438322f, 0.562447488f, 0.563457549f, 0.564468503f, 0.565480292f,
+	0.566492975f, 0.567506552f, 0.568521023f, 0.569536388f, 0.570552588f, 0.571569681f,
+	0.572587729f, 0.57360661f, 0.574626386f, 0.575647116f, 0.57666868f, 0.577691197f,
+	0.578714609f, 0.579738915f, 0.580764174f, 0.581790328f, 0.582817376f, 0.583845317f,
+	0.584874272f, 0.585904062f, 0.586934805f, 0.587966502f, 0.588999093f, 0.590032637f,
+	0.591067135f, 0.592102528f, 0.593138874f, 0.594176173f, 0.595214427f, 0.596253633f,
+	0.597293794f, 0.598334908f, 0.599376917f, 0.600419939f, 0.601463914f, 0.602508843f,
+	0.603554785f, 0.604601622f, 0.605649471f, 0.606698275f, 0.607748091f, 0.608798862f,
+	0.609850645f, 0.610903382f, 0.611957073f, 0.613011837f, 0.614067495f, 0.615124226f,
+	0.61618191f, 0.617240608f, 0.618300319f, 0.619361043f, 0.620422781f, 0.621485472f,
+	0.622549236f, 0.623614013f, 0.624679744f, 0.625746548f, 0.626814425f, 0.627883255f,
+	0.628953159f, 0.630024076f, 0.631096005f, 0.632169008f, 0.633243024f, 0.634318113f,
+	0.635394216f, 0.636471391f, 0.637549579f, 0.6386289f, 0.639709234f, 0.640790582f,
+	0.641873062f, 0.642956614f, 0.644041181f, 0.645126879f, 0.646213591f, 0.647301435f,
+	0.648390293f, 0.649480283f, 0.650571346f, 0.651663542f, 0.652756751f, 0.653851092f,
+	0.654946566f, 0.656043112f, 0.657140732f, 0.658239543f, 0.659339368f, 0.660440385f,
+	0.661542475f, 0.662645698f, 0.663749993f, 0.66485548f, 0.66596204f, 0.667069793f,
+	0.668178618f, 0.669288635f, 0.670399785f, 0.671512067f, 0.672625482f, 0.673740029f,
+	0.674855769f, 0.675972641f, 0.677090645f, 0.678209901f, 0.67933023f, 0.680451751f,
+	0.681574464f, 0.682698369f, 0.683823407f, 0.684949636f, 0.686077058f, 0.687205672f,
+	0.688335478f, 0.689466476f, 0.690598667f, 0.691732049f, 0.692866623f, 0.69400245f,
+	0.695139468f, 0.696277678f, 0.69741708f, 0.698557734f, 0.69969964f, 0.700842738f,
+	0.701987088f, 0.703132629f, 0.704279482f, 0.705427527f, 0.706576824f, 0.707727313f,
+	0.708879113f, 0.710032165f, 0.711186469f, 0.712342024f, 0.713498831f, 0.714656889f,
+	0.715816259f, 0.716976881f, 0.718138814f, 0.719301999f, 0.720466435f, 0.721632183f,
+	0.722799242f, 0.723967612f, 0.725137234f, 0.726308167f, 0.727480412f, 0.728653967f,
+	0.729828835f, 0.731005073f, 0.732182562f, 0.733361363f, 0.734541535f, 0.735723019f,
+	0.736905873f, 0.738089979f, 0.739275515f, 0.740462363f, 0.741650522f, 0.742840111f,
+	0.744031012f, 0.745223284f, 0.746416867f, 0.74761188f, 0.748808265f, 0.75000596f,
+	0.751205087f, 0.752405584f, 0.753607512f, 0.75481075f, 0.75601542f, 0.75722152f,
+	0.758428991f, 0.759637892f, 0.760848165f, 0.762059867f, 0.763273001f, 0.764487505f,
+	0.765703499f, 0.766920865f, 0.76813972f, 0.769359946f, 0.770581663f, 0.77180481f,
+	0.773029387f, 0.774255455f, 0.775482953f, 0.776711941f, 0.777942359f, 0.779174268f,
+	0.780407667f, 0.781642497f, 0.782878876f, 0.784116685f, 0.785355985f, 0.786596775f,
+	0.787839115f, 0.789082885f, 0.790328205f, 0.791575015f, 0.792823374f, 0.794073224f,
+	0.795324624f, 0.796577513f, 0.797831953f, 0.799087942f, 0.800345421f, 0.801604509f,
+	0.802865148f, 0.804127276f, 0.805391014f, 0.806656301f, 0.807923138f, 0.809191585f,
+	0.810461581f, 0.811733127f, 0.813006282f, 0.814281046f, 0.81555742f, 0.816835344f,
+	0.818114877f, 0.819396019f, 0.820678771f, 0.821963191f, 0.823249161f, 0.8245368f,
+	0.825826049f, 0.827116907f, 0.828409433f, 0.829703629f, 0.830999434f, 0.832296908f,
+	0.833596051f, 0.834896803f, 0.836199284f, 0.837503433f, 0.838809252f, 0.840116739f,
+	0.841425896f, 0.842736721f, 0.844049335f, 0.845363557f, 0.846679509f, 0.847997189f,
+	0.849316597f, 0.850637734f, 0.85196054f, 0.853285134f, 0.854611397f, 0.855939448f,
+	0.857269228f, 0.858600795f, 0.859934092f, 0.861269116f, 0.862605929f, 0.86394453f,
+	0.86528486f, 0.866627038f, 0.867970943f, 0.869316638f, 0.870664179f, 0.872013509f,
+	0.873364627f, 0.874717534f, 0.876072288f, 0.87742883f, 0.878787279f, 0.880147457f,
+	0.881509542f, 0.882873476f, 0.884239197f, 0.885606825f, 0.886976302f, 0.888347626f,
+	0.889720857f, 0.891095936f, 0.892472863f, 0.893851757f, 0.895232499f, 0.896615088f,
+	0.897999644f, 0.899386108f, 0.900774479f, 0.902164757f, 0.903556943f, 0.904951096f,
+	0.906347156f, 0.907745183f, 0.909145176f, 0.910547078f, 0.911950946f, 0.913356781f,
+	0.914764643f, 0.916174412f, 0.917586207f, 0.91899997f, 0.920415699f, 0.921833456f,
+	0.923253238f, 0.924674988f, 0.926098824f, 0.927524626f, 0.928952456f, 0.930382371f,
+	0.931814313f, 0.933248281f, 0.934684277f, 0.936122358f, 0.937562525f, 0.939004779f,
+	0.940449059f, 0.941895485f, 0.943343937f, 0.944794536f, 0.94624722f, 0.94770205f,
+	0.949158967f, 0.950617969f, 0.952079117f, 0.953542471f, 0.955007911f, 0.956475496f,
+	0.957945228f, 0.959417164f, 0.960891187f, 0.962367475f, 0.963845909f, 0.965326488f,
+	0.966809332f, 0.968294322f, 0.969781578f, 0.971270978f, 0.972762644f, 0.974256516f,
+	0.975752652f, 0.977250993f, 0.9787516f, 0.980254471f, 0.981759608f, 0.983267009f,
+	0.984776676f, 0.986288607f, 0.987802863f, 0.989319384f, 0.99083823f, 0.99235934f,
+	0.993882835f, 0.995408595f, 0.996936738f, 0.998467207f, 1.0f, 1.00153518f,
+	1.00307262f, 1.00461257f, 1.00615478f, 1.00769949f, 1.00924647f, 1.01079595f,
+	1.01234782f, 1.01390207f, 1.0154587f, 1.01701772f, 1.01857924f, 1.02014327f,
+	1.02170968f, 1.02327859f, 1.02484989f, 1.02642369f, 1.028f, 1.0295788f,
+	1.03116f, 1.03274381f, 1.03433013f, 1.03591895f, 1.03751028f, 1.0391041f,
+	1.04070055f, 1.04229951f, 1.04390097f, 1.04550505f, 1.04711175f, 1.04872096f,
+	1.0503329f, 1.05194724f, 1.05356431f, 1.05518401f, 1.05680621f, 1.05843115f,
+	1.06005871f, 1.0616889f, 1.06332183f, 1.06495726f, 1.06659555f, 1.06823635f,
+	1.06988001f, 1.07152629f, 1.07317519f, 1.07482696f, 1.07648134f, 1.07813847f,
+	1.07979834f, 1.08146107f, 1.08312643f, 1.08479464f, 1.0864656f, 1.0881393f,
+	1.08981586f, 1.09149528f, 1.09317744f, 1.09486234f, 1.09655023f, 1.09824085f,
+	1.09993434f, 1.10163069f, 1.10333002f, 1.10503209f, 1.10673714f, 1.10844505f,
+	1.11015582f, 1.11186957f, 1.11358619f, 1.11530578f, 1.11702824f, 1.11875379f,
+	1.12048221f, 1.1222136f, 1.1239481f, 1.12568545f, 1.12742579f, 1.12916923f,
+	1.13091564f, 1.13266516f, 1.13441765f, 1.13617325f, 1.13793182f, 1.1396935f,
+	1.14145827f, 1.14322615f, 1.14499712f, 1.14677131f, 1.14854848f, 1.15032876f,
+	1.15211225f, 1.15389895f, 1.15568876f, 1.15748179f, 1.15927792f, 1.16107726f,
+	1.16287982f, 1.16468561f, 1.16649473f, 1.16830695f, 1.1701225f, 1.17194128f,
+	1.17376328f, 1.17558861f, 1.17741728f, 1.17924917f, 1.18108439f, 1.18292296f,
+	1.18476486f, 1.18661022f, 1.1884588f, 1.19031084f, 1.19216621f, 1.19402492f,
+	1.19588721f, 1.19775283f, 1.1996218f, 1.20149434f, 1.20337021f, 1.20524967f,
+	1.20713258f, 1.20901895f, 1.21090877f, 1.21280217f, 1.21469903f, 1.21659958f,
+	1.21850348f, 1.22041106f, 1.22232223f, 1.22423697f, 1.22615528f, 1.22807717f,
+	1.23000276f, 1.23193192f, 1.23386478f, 1.23580134f, 1.23774147f, 1.23968542f,
+	1.24163294f, 1.24358428f, 1.24553919f, 1.24749792f, 1.24946046f, 1.2514267f,
+	1.25339675f, 1.25537062f, 1.2573483f, 1.25932968f, 1.26131499f, 1.26330411f,
+	1.26529706f, 1.26729393f, 1.26929474f, 1.27129936f, 1.27330792f, 1.27532041f,
+	1.27733684f, 1.27935719f, 1.28138161f, 1.28340995f, 1.28544223f, 1.28747857f,
+	1.28951895f, 1.29156339f, 1.29361188f, 1.29566431f, 1.29772103f, 1.29978168f,
+	1.3018465f, 1.3039155f, 1.30598855f, 1.30806589f, 1.31014729f, 1.31223285f,
+	1.31432271f, 1.31641674f, 1.31851494f, 1.32061756f, 1.32272434f, 1.3248353f,
+	1.32695067f, 1.32907033f, 1.3311944f, 1.33332264f, 1.33545542f, 1.33759248f,
+	1.33973384f, 1.34187973f, 1.34403002f, 1.34618473f, 1.34834397f, 1.3505075f,
+	1.35267568f, 1.35484827f, 1.3570255f, 1.35920715f, 1.36139345f, 1.36358416f,
+	1.36577964f, 1.36797965f, 1.37018418f, 1.37239349f, 1.37460744f, 1.37682605f,
+	1.3790493f, 1.38127732f, 1.38350999f, 1.38574743f, 1.38798964f, 1.39023674f,
+	1.39248848f, 1.39474511f, 1.39700651f, 1.3992728f, 1.40154397f, 1.40382004f,
+	1.40610099f, 1.40838695f, 1.41067779f, 1.41297352f, 1.41527438f, 1.41758013f,
+	1.41989088f, 1.42220676f, 1.42452765f, 1.42685366f, 1.42918468f, 1.43152082f,
+	1.43386221f, 1.43620861f, 1.43856025f, 1.44091713f, 1.44327915f, 1.44564652f,
+	1.44801903f, 1.4503969f, 1.45278001f, 1.45516837f, 1.45756221f, 1.4599613f,
+	1.46236587f, 1.4647758f, 1.4671911f, 1.46961188f, 1.47203815f, 1.47446978f,
+	1.47690701f, 1.47934985f, 1.48179817f, 1.48425198f, 1.4867115f, 1.48917663f,
+	1.49164736f, 1.4941237f, 1.49660575f, 1.49909353f, 1.50158703f, 1.50408626f,
+	1.50659132f, 1.50910211f, 1.51161873f, 1.5141412f, 1.51666963f, 1.51920378f,
+	1.52174401f, 1.52429008f, 1.52684212f, 1.52940011f, 1.53196418f, 1.53453422f,
+	1.53711045f, 1.53969264f, 1.54228091f, 1.54487538f, 1.54747593f, 1.5500828f,
+	1.55269575f, 1.5553149f, 1.55794048f, 1.56057215f, 1.56321025f, 1.56585467f,
+	1.56850541f, 1.57116258f, 1.57382607f, 1.57649612f, 1.57917261f, 1.58185554f,
+	1.58454502f, 1.58724105f, 1.58994353f, 1.5926528f, 1.59536862f, 1.59809101f,
+	1.60082018f, 1.60355604f, 1.60629869f, 1.60904801f, 1.61180413f, 1.61456716f,
+	1.61733699f, 1.62011373f, 1.62289727f, 1.62568784f, 1.62848544f, 1.63128996f,
+	1.63410151f, 1.63692009f, 1.63974583f, 1.6425786f, 1.64541852f, 1.64826572f,
+	1.65112007f, 1.65398169f, 1.65685046f, 1.65972662f, 1.66261017f, 1.665501f,
+	1.66839921f, 1.67130482f, 1.67421806f, 1.67713857f, 1.68006682f, 1.68300247f,
+	1.68594575f, 1.68889666f, 1.69185519f, 1.69482148f, 1.69779551f, 1.70077717f,
+	1.7037667f, 1.7067641f, 1.70976925f, 1.71278238f, 1.71580338f, 1.71883237f,
+	1.72186935f, 1.72491431f, 1.72796738f, 1.73102856f, 1.73409796f, 1.73717546f,
+	1.74026108f, 1.74335504f, 1.74645734f, 1.74956787f, 1.75268686f, 1.75581419f,
+	1.75894988f, 1.76209414f, 1.76524687f, 1.76840818f, 1.77157807f, 1.77475655f,
+	1.77794373f, 1.78113961f, 1.7843442f, 1.7875576f, 1.79077983f, 1.79401088f,
+	1.79725087f, 1.8004998f, 1.80375767f, 1.80702472f, 1.81030071f, 1.81358576f,
+	1.81688011f, 1.82018352f, 1.82349622f, 1.82681823f, 1.83014953f, 1.83349025f,
+	1.83684027f, 1.84019983f, 1.84356892f, 1.84694743f, 1.8503356f, 1.85373342f,
+	1.8571409f, 1.86055803f, 1.86398506f, 1.86742175f, 1.87086844f, 1.87432492f,
+	1.8777914f, 1.88126791f, 1.88475442f, 1.88825107f, 1.89175785f, 1.89527476f,
+	1.89880204f, 1.90233946f, 1.90588725f, 1.90944552f, 1.91301417f, 1.91659331f,
+	1.92018294f, 1.9237833f, 1.92739415f, 1.93101573f, 1.93464804f, 1.93829119f,
+	1.9419452f, 1.94561005f, 1.94928598f, 1.95297277f, 1.95667076f, 1.96037972f,
+	1.96409988f, 1.96783137f, 1.97157407f, 1.97532809f, 1.97909355f, 1.98287046f,
+	1.98665881f, 1.99045873f, 1.99427032f, 1.99809361f, 2.00192857f, 2.00577521f,
+	2.00963402f, 2.01350451f, 2.01738691f, 2.02128148f, 2.02518821f, 2.02910709f,
+	2.03303814f, 2.03698134f, 2.04093695f, 2.04490495f, 2.04888558f, 2.05287862f,
+	2.05688429f, 2.0609026f, 2.06493354f, 2.06897736f, 2.07303405f, 2.07710361f,
+	2.08118606f, 2.08528185f, 2.08939052f, 2.09351254f, 2.09764767f, 2.10179615f,
+	2.10595798f, 2.11013341f, 2.11432242f, 2.11852479f, 2.12274098f, 2.12697101f,
+	2.13121486f, 2.13547254f, 2.13974428f, 2.14402986f, 2.14832973f, 2.15264368f,
+	2.15697193f, 2.16131449f, 2.16567159f, 2.17004323f, 2.17442918f, 2.17883015f,
+	2.18324566f, 2.18767595f, 2.19212103f, 2.19658136f, 2.20105648f, 2.20554686f,
+	2.21005249f, 2.21457338f, 2.21910954f, 2.22366142f, 2.22822857f, 2.23281169f,
+	2.23741031f, 2.24202466f, 2.24665499f, 2.25130153f, 2.2559638f, 2.26064253f,
+	2.26533723f, 2.27004838f, 2.27477598f, 2.27952027f, 2.28428102f, 2.28905845f,
+	2.29385281f, 2.29866385f, 2.30349207f, 2.30833745f, 2.31319976f, 2.31807947f,
+	2.32297659f, 2.32789111f, 2.33282351f, 2.33777332f, 2.34274101f, 2.34772635f,
+	2.35273004f, 2.35775161f, 2.3627913f, 2.36784935f, 2.372926f, 2.378021f,
+	2.3831346f, 2.38826704f, 2.39341807f, 2.39858842f, 2.4037776f, 2.40898585f,
+	2.41421366f, 2.41946054f, 2.4247272f, 2.43001342f, 2.43531942f, 2.44064498f,
+	2.4459908f, 2.45135665f, 2.45674276f, 2.46214914f, 2.46757603f, 2.47302365f,
+	2.47849178f, 2.48398066f, 2.48949075f, 2.49502158f, 2.50057387f, 2.50614738f,
+	2.51174259f, 2.51735926f, 2.52299762f, 2.52865767f, 2.5343399f, 2.54004431f,
+	2.54577088f, 2.55152011f, 2.55729151f, 2.56308579f, 2.56890297f, 2.57474303f,
+	2.58060622f, 2.58649278f, 2.59240246f, 2.59833598f, 2.60429287f, 2.61027384f,
+	2.61627889f, 2.62230802f, 2.62836123f, 2.63443923f, 2.64054155f, 2.64666867f,
+	2.65282083f, 2.65899825f, 2.66520071f, 2.67142844f, 2.67768192f, 2.68396115f,
+	2.69026613f, 2.69659734f, 2.70295477f, 2.70933867f, 2.71574903f, 2.72218633f,
+	2.72865033f, 2.73514152f, 2.74166012f, 2.74820614f, 2.75477982f, 2.76138115f,
+	2.76801085f, 2.77466846f, 2.78135467f, 2.78806925f, 2.79481268f, 2.8015852f,
+	2.8083868f, 2.81521773f, 2.82207847f, 2.82896876f, 2.83588886f, 2.84283948f,
+	2.84982038f, 2.85683179f, 2.86387396f, 2.87094712f, 2.87805152f, 2.88518739f,
+	2.89235497f, 2.89955425f, 2.90678573f, 2.91404963f, 2.92134595f, 2.92867494f,
+	2.93603706f, 2.94343257f, 2.95086122f, 2.95832372f, 2.96582031f, 2.973351f,
+	2.98091602f, 2.98851562f, 2.99615026f, 3.00382018f, 3.01152539f, 3.01926637f,
+	3.0270431f, 3.03485632f, 3.04270577f, 3.05059195f, 3.05851531f, 3.06647563f,
+	3.07447386f, 3.08250952f, 3.09058356f, 3.09869576f, 3.10684681f, 3.11503673f,
+	3.12326574f, 3.13153434f, 3.13984275f, 3.14819145f, 3.15658045f, 3.16500998f,
+	3.17348075f, 3.18199277f, 3.19054651f, 3.19914222f, 3.20778012f, 3.2164607f,
+	3.2251842f, 3.23395109f, 3.24276137f, 3.25161576f, 3.26051426f, 3.26945734f,
+	3.27844548f, 3.28747916f, 3.29655814f, 3.30568337f, 3.31485486f, 3.32407331f,
+	3.33333874f, 3.34265161f, 3.3520124f, 3.36142159f, 3.37087917f, 3.38038611f,
+	3.38994217f, 3.39954829f, 3.40920448f, 3.41891122f, 3.42866921f, 3.43847847f,
+	3.4483397f, 3.45825338f, 3.46821952f, 3.47823906f, 3.48831201f, 3.49843907f,
+	3.50862074f, 3.51885724f, 3.52914906f, 3.5394969f, 3.54990101f, 3.56036186f,
+	3.57088017f, 3.58145618f, 3.59209037f, 3.60278344f, 3.61353564f, 3.62434769f,
+	3.63522005f, 3.64615321f, 3.65714765f, 3.66820383f, 3.67932248f, 3.69050431f,
+	3.70174932f, 3.71305847f, 3.72443223f, 3.73587108f, 3.74737573f, 3.75894666f,
+	3.77058458f, 3.78228998f, 3.79406333f, 3.80590558f, 3.81781721f, 3.8297987f,
+	3.84185076f, 3.8539741f, 3.86616945f, 3.87843728f, 3.89077806f, 3.903193f,
+	3.91568255f, 3.92824721f, 3.94088769f, 3.95360494f, 3.96639967f, 3.97927237f,
+	3.99222374f, 4.00525475f, 4.01836634f, 4.03155851f, 4.04483318f, 4.05818987f,
+	4.07163f, 4.08515453f, 4.09876442f, 4.11245966f, 4.12624168f, 4.14011145f,
+	4.15406942f, 4.16811657f, 4.18225384f, 4.1964817f, 4.21080208f, 4.22521496f,
+	4.23972178f, 4.25432301f, 4.26902008f, 4.28381348f, 4.29870415f, 4.313694f,
+	4.32878304f, 4.34397268f, 4.35926342f, 4.37465715f, 4.39015484f, 4.40575695f,
+	4.42146444f, 4.43727922f, 4.45320225f, 4.46923399f, 4.48537636f, 4.50163031f,
+	4.51799631f, 4.53447676f, 4.55107164f, 4.56778336f, 4.58461189f, 4.60155964f,
+	4.61862755f, 4.63581657f, 4.65312862f, 4.67056417f, 4.68812513f, 4.70581341f,
+	4.72362947f, 4.74157476f, 4.75965166f, 4.77786064f, 4.79620361f, 4.81468201f,
+	4.83329773f, 4.85205173f, 4.87094593f, 4.88998175f, 4.90916061f, 4.92848492f,
+	4.94795561f, 4.9675746f, 4.98734379f, 5.00726509f, 5.02733946f, 5.04756975f,
+	5.06795692f, 5.08850336f, 5.10921049f, 5.1300807f, 5.15111589f, 5.17231798f,
+	5.19368935f, 5.21523094f, 5.23694611f, 5.25883627f, 5.28090334f, 5.30315018f,
+	5.32557917f, 5.34819174f, 5.37099028f, 5.39397812f, 5.41715622f, 5.44052839f,
+	5.46409607f, 5.48786211f, 5.51182938f, 5.53599977f, 5.56037664f, 5.58496189f,
+	5.60975885f, 5.63477039f, 5.65999889f, 5.68544722f, 5.7111187f, 5.73701572f,
+	5.76314211f, 5.78950024f, 5.81609344f, 5.84292507f, 5.86999846f, 5.89731646f,
+	5.92488289f, 5.95270061f, 5.98077393f, 6.00910568f, 6.03770018f, 6.06656075f,
+	6.09569073f, 6.12509489f, 6.1547761f, 6.18473911f, 6.21498775f, 6.24552631f,
+	6.2763586f, 6.3074894f, 6.3389225f,
+};
+
+// 2^x for x in [-EXP2_TABLE_OCTAVES, EXP2_TABLE_OCTAVES]: 2^(j / EXP2_TABLE_RESOLUTION)
+// across one octave, and the whole octaves from 2^-EXP2_TABLE_OCTAVES
+static const int EXP2_TABLE_RESOLUTION = 256;
+static const int EXP2_TABLE_OCTAVES = 10;
+
+static const float exp2FractionTable[257] = {
+	1.0f, 1.0027113f, 1.00542986f, 1.00815594f, 1.01088929f, 1.01363003f,
+	1.01637828f, 1.01913404f, 1.0218972f, 1.02466774f, 1.02744591f, 1.0302316f,
+	1.03302491f, 1.03582573f, 1.03863406f, 1.04145014f, 1.04427373f, 1.04710507f,
+	1.04994404f, 1.05279076f, 1.05564523f, 1.05850732f, 1.06137717f, 1.06425488f,
+	1.06714046f, 1.07003367f, 1.07293487f, 1.07584393f, 1.07876074f, 1.08168566f,
+	1.08461833f, 1.0875591f, 1.09050775f, 1.09346437f, 1.09642911f, 1.09940183f,
+	1.10238254f, 1.10537148f, 1.1083684f, 1.11137354f, 1.1143868f, 1.11740816f,
+	1.12043774f, 1.12347555f, 1.12652159f, 1.12957597f, 1.13263857f, 1.1357094f,
+	1.13878858f, 1.14187622f, 1.14497209f, 1.14807653f, 1.15118921f, 1.15431046f,
+	1.15744007f, 1.16057825f, 1.1637249f, 1.16688001f, 1.17004383f, 1.1732161f,
+	1.17639697f, 1.17958653f, 1.18278468f, 1.18599153f, 1.18920708f, 1.19243133f,
+	1.19566441f, 1.19890618f, 1.20215678f, 1.20541608f, 1.20868433f, 1.21196139f,
+	1.21524739f, 1.21854222f, 1.22184598f, 1.22515881f, 1.22848058f, 1.23181129f,
+	1.23515105f, 1.23849988f, 1.24185777f, 1.24522483f, 1.24860096f, 1.25198627f,
+	1.25538075f, 1.25878441f, 1.26219738f, 1.26561952f, 1.26905096f, 1.27249169f,
+	1.27594173f, 1.27940118f, 1.28287005f, 1.28634822f, 1.28983593f, 1.29333293f,
+	1.29683959f, 1.30035567f, 1.30388129f, 1.30741644f, 1.31096125f, 1.31451559f,
+	1.31807959f, 1.32165325f, 1.32523668f, 1.32882977f, 1.33243251f, 1.33604515f,
+	1.33966756f, 1.34329975f, 1.34694183f, 1.35059369f, 1.35425556f, 1.35792732f,
+	1.36160898f, 1.36530077f, 1.36900246f, 1.37271416f, 1.376436f, 1.38016784f,
+	1.38390994f, 1.38766205f, 1.39142442f, 1.39519691f, 1.39897966f, 1.40277267f,
+	1.40657604f, 1.41038966f, 1.41421354f, 1.4180479f, 1.42189264f, 1.42574775f,
+	1.42961335f, 1.43348944f, 1.43737602f, 1.44127309f, 1.44518077f, 1.44909906f,
+	1.45302796f, 1.45696759f, 1.46091783f, 1.4648788f, 1.46885037f, 1.47283292f,
+	1.47682619f, 1.48083019f, 1.48484516f, 1.48887098f, 1.49290776f, 1.49695539f,
+	1.50101411f, 1.50508368f, 1.50916445f, 1.51325619f, 1.51735902f, 1.52147305f,
+	1.52559817f, 1.52973449f, 1.53388202f, 1.53804076f, 1.54221082f, 1.5463922f,
+	1.55058491f, 1.55478895f, 1.55900443f, 1.56323135f, 1.5674696f, 1.57171953f,
+	1.5759809f, 1.58025372f, 1.58453822f, 1.5888344f, 1.59314215f, 1.59746158f,
+	1.60179281f, 1.60613561f, 1.61049032f, 1.61485684f, 1.61923516f, 1.62362528f,
+	1.62802744f, 1.6324414f, 1.6368674f, 1.64130545f, 1.64575553f, 1.65021753f,
+	1.65469182f, 1.65917814f, 1.66367662f, 1.66818726f, 1.67271018f, 1.67724538f,
+	1.68179286f, 1.68635261f, 1.69092476f, 1.69550931f, 1.70010638f, 1.70471585f,
+	1.70933771f, 1.71397221f, 1.71861935f, 1.723279f, 1.72795129f, 1.73263621f,
+	1.73733389f, 1.74204421f, 1.7467674f, 1.75150335f, 1.75625217f, 1.76101387f,
+	1.76578844f, 1.770576f, 1.77537644f, 1.78018999f, 1.78501666f, 1.78985631f,
+	1.79470909f, 1.79957497f, 1.80445421f, 1.80934656f, 1.81425214f, 1.81917107f,
+	1.82410336f, 1.82904899f, 1.8340081f, 1.83898056f, 1.8439666f, 1.84896612f,
+	1.85397911f, 1.85900581f, 1.8640461f, 1.86909997f, 1.87416768f, 1.87924898f,
+	1.88434422f, 1.88945317f, 1.89457595f, 1.89971268f, 1.90486336f, 1.91002798f,
+	1.91520655f, 1.92039919f, 1.92560589f, 1.93082678f, 1.93606174f, 1.941311f,
+	1.94657445f, 1.95185208f, 1.95714414f, 1.9624505f, 1.96777117f, 1.97310638f,
+	1.97845602f, 1.9838202f, 1.9891988f, 1.99459207f, 2.0f,
+};
+
+static const float exp2OctaveTable[21] = {
+	0.0009765625f, 0.001953125f, 0.00390625f, 0.0078125f, 0.015625f, 0.03125f,
+	0.0625f, 0.125f, 0.25f, 0.5f, 1.0f, 2.0f,
+	4.0f, 8.0f, 16.0f, 32.0f, 64.0f, 128.0f,
+	256.0f, 512.0f, 1024.0f,
+};
+
+// Diode curve: cubic per interval of 1 / DIODE_TABLE_RESOLUTION over
+// [DIODE_TABLE_MIN, DIODE_TABLE_MAX], in the position u within it
+static const float DIODE_TABLE_MIN = -6.0f;
+static const float DIODE_TABLE_MAX = 12.0f;
+static const float DIODE_TABLE_RESOLUTION = 8.0f;
+static const int DIODE_TABLE_INTERVALS = 144;
+
+struct _tangentsSaturatorInterval
+{
+	float c0, c1, c2, c3;   // curve = c0 + c1 u + c2 u^2 + c3 u^3, u in [0, 1]
+	float F;                // antiderivative at u = 0, zero at x = 0
+};
+
+static const _tangentsSaturatorInterval diodeTable[144] = {
+	{ -0.49999693f, 7.68026553e-07f, 9.54500194e-08f, 9.0796739e-09f, 2.75000286f },
+	{ -0.499996066f, 9.8616556e-07f, 1.22560252e-07f, 1.16585319e-08f, 2.68750334f },
+	{ -0.499994934f, 1.26626173e-06f, 1.57370479e-07f, 1.49698511e-08f, 2.62500381f },
+	{ -0.499993503f, 1.6259122e-06f, 2.02067696e-07f, 1.92216696e-08f, 2.56250453f },
+	{ -0.499991655f, 2.08771257e-06f, 2.59460052e-07f, 2.46811123e-08f, 2.50000548f },
+	{ -0.499989271f, 2.68067606e-06f, 3.33153309e-07f, 3.16911759e-08f, 2.43750668f },
+	{ -0.499986231f, 3.44205614e-06f, 4.27777309e-07f, 4.06922744e-08f, 2.37500834f },
+	{ -0.499982327f, 4.41968768e-06f, 5.49276933e-07f, 5.22499128e-08f, 2.31251025f },
+	{ -0.499977291f, 5.67499137e-06f, 7.05285572e-07f, 6.70902196e-08f, 2.25001264f },
+	{ -0.499970853f, 7.2868329e-06f, 9.05604566e-07f, 8.61455476e-08f, 2.18751597f },
+	{ -0.499962568f, 9.35647859e-06f, 1.16281933e-06f, 1.10613072e-07f, 2.12502003f },
+	{ -0.499951959f, 1.20139566e-05f, 1.49308948e-06f, 1.4202999e-07f, 2.06252527f },
+	{ -0.499938309f, 1.54262252e-05f, 1.91716481e-06f, 1.82370115e-07f, 2.00003219f },
+	{ -0.499920756f, 1.9807665e-05f, 2.46168838e-06f, 2.34167871e-07f, 1.93754101f },
+	{ -0.499898255f, 2.54335464e-05f, 3.16087062e-06f, 3.00677499e-07f, 1.87505221f },
+	{ -0.499869376f, 3.26573208e-05f, 4.0586383e-06f, 3.86077545e-07f, 1.81256664f },
+	{ -0.499832273f, 4.1932828e-05f, 5.21139464e-06f, 4.95733389e-07f, 1.75008523f },
+	{ -0.499784619f, 5.38428176e-05f, 6.69156316e-06f, 6.36534253e-07f, 1.68760908f },
+	{ -0.499723464f, 6.91355453e-05f, 8.59213651e-06f, 8.17326168e-07f, 1.62513959f },
+	{ -0.499644905f, 8.87717979e-05f, 1.10325218e-05f, 1.04946764e-06f, 1.56267893f },
+	{ -0.499544054f, 0.000113985247f, 1.41660385e-05f, 1.34754305e-06f, 1.50022936f },
+	{ -0.499414563f, 0.000146359947f, 1.81895539e-05f, 1.73027956e-06f, 1.43779409f },
+	{ -0.499248266f, 0.000187929894f, 2.33558494e-05f, 2.22172298e-06f, 1.37537718f },
+	{ -0.499034762f, 0.00024130677f, 2.99895037e-05f, 2.85274859e-06f, 1.31298399f },
+	{ -0.498760611f, 0.000309844036f, 3.85072854e-05f, 3.66300173e-06f, 1.25062108f },
+	{ -0.498408616f, 0.000397847587f, 4.94443339e-05f, 4.70338728e-06f, 1.18829703f },
+	{ -0.497956604f, 0.000510846439f, 6.34877797e-05f, 6.03926901e-06f, 1.12602305f },
+	{ -0.497376233f, 0.000655939803f, 8.15199237e-05f, 7.75457465e-06f, 1.06381321f },
+	{ -0.496631026f, 0.000842243375f, 0.000104673658f, 9.9570716e-06f, 1.00168586f },
+	{ -0.495674163f, 0.0010814619f, 0.000134403628f, 1.27851326e-05f, 0.939664245f },
+	{ -0.494445503f, 0.00138862454f, 0.000172577682f, 1.64164358e-05f, 0.87777859f },
+	{ -0.492867887f, 0.00178302929f, 0.000221594135f, 2.10791204e-05f, 0.816067398f },
+	{ -0.490842193f, 0.00228945492f, 0.000284532493f, 2.70661258e-05f, 0.754580259f },
+	{ -0.488241136f, 0.00293971831f, 0.000365346961f, 3.47535934e-05f, 0.693380773f },
+	{ -0.484901309f, 0.00377467298f, 0.000469114777f, 4.46244958e-05f, 0.632550657f },
+	{ -0.480612904f, 0.0048467759f, 0.000602355285f, 5.72989884e-05f, 0.572194874f },
+	{ -0.475106478f, 0.00622338336f, 0.000773439533f, 7.35733556e-05f, 0.512448072f },
+	{ -0.468036056f, 0.00799098238f, 0.000993115944f, 9.44700587e-05f, 0.453483224f },
+	{ -0.458957493f, 0.0102606248f, 0.00127518619f, 0.000121301957f, 0.395522505f },
+	{ -0.447300375f, 0.0131749026f, 0.00163737149f, 0.000155754795f, 0.338851005f },
+	{ -0.432332367f, 0.0169169102f, 0.00210242649f, 0.000199993126f, 0.283834994f },
+	{ -0.413113028f, 0.021721743f, 0.0026995691f, 0.000256796251f, 0.230944604f },
+	{ -0.388434917f, 0.0278912708f, 0.00346631533f, 0.000329732924f, 0.1807836f },
+	{ -0.356747597f, 0.0358131006f, 0.00445083715f, 0.000423385442f, 0.13412717f },
+	{ -0.316060275f, 0.0459849313f, 0.00571498787f, 0.000543637667f, 0.0919707194f },
+	{ -0.263816714f, 0.0590458177f, 0.00733818999f, 0.000698044605f, 0.0555923544f },
+	{ -0.196734667f, 0.0758163333f, 0.00942242239f, 0.000896306999f, 0.0266331974f },
+	{ -0.110599607f, 0.0973500982f, 0.01209863f, 0.00115088094f, 0.00720049534f },
+	{ 0.0f, 0.125f, -0.00780282076f, 0.000305917987f, 0.0f },
+	{ 0.117503099f, 0.110312112f, -0.00688596489f, 0.000269971672f, 0.0074969423f },
+	{ 0.221199214f, 0.0973500982f, -0.00607684255f, 0.000238249166f, 0.0288008582f },
+	{ 0.312710732f, 0.0859111622f, -0.00536279473f, 0.000210254162f, 0.0622893833f },
+	{ 0.393469334f, 0.0758163333f, -0.00473264977f, 0.000185548648f, 0.106530793f },
+	{ 0.464738578f, 0.0669076815f, -0.00417654868f, 0.000163746095f, 0.160261586f },
+	{ 0.527633429f, 0.0590458177f, -0.00368579151f, 0.000144505422f, 0.222366735f },
+	{ 0.583137989f, 0.0521077514f, -0.00325269951f, 0.000127525593f, 0.29186222f },
+	{ 0.63212055f, 0.0459849313f, -0.00287049729f, 0.00011254094f, 0.367879659f },
+	{ 0.675347507f, 0.0405815579f, -0.00253320485f, 9.93170324e-05f, 0.449652702f },
+	{ 0.713495195f, 0.0358131006f, -0.00223554554f, 8.76469712e-05f, 0.536505044f },
+	{ 0.747160375f, 0.0316049494f, -0.00197286205f, 7.73481806e-05f, 0.627839863f },
+	{ 0.776869833f, 0.0278912708f, -0.00174104457f, 6.82595273e-05f, 0.723130405f },
+	{ 0.803088307f, 0.0246139597f, -0.00153646641f, 6.02388245e-05f, 0.821911931f },
+	{ 0.826226056f, 0.021721743f, -0.00135592686f, 5.31605765e-05f, 0.923774242f },
+	{ 0.846645057f, 0.0191693716f, -0.00119660131f, 4.69140432e-05f, 1.02835524f },
+	{ 0.864664733f, 0.0169169102f, -0.00105599698f, 4.14014976e-05f, 1.13533556f },
+	{ 0.880567014f, 0.0149291214f, -0.000931914023f, 3.65366941e-05f, 1.24443328f },
+	{ 0.894600749f, 0.0131749026f, -0.00082241121f, 3.22435189e-05f, 1.35539949f },
+	{ 0.906985521f, 0.0116268108f, -0.000725775375f, 2.84548059e-05f, 1.46801484f },
+	{ 0.917914987f, 0.0102606248f, -0.000640494516f, 2.51112779e-05f, 1.58208525f },
+	{ 0.92756027f, 0.00905497f, -0.000565234455f, 2.21606242e-05f, 1.69744003f },
+	{ 0.936072111f, 0.00799098238f, -0.000498817652f, 1.95566827e-05f, 1.81392813f },
+	{ 0.943583846f, 0.00705201738f, -0.000440205011f, 1.72587115e-05f, 1.93141651f },
+	{ 0.950212955f, 0.00622338336f, -0.000388479559f, 1.52307603e-05f, 2.04978728f },
+	{ 0.956063092f, 0.00549211679f, -0.000342832005f, 1.34410984e-05f, 2.16893721f },
+	{ 0.961225808f, 0.0048467759f, -0.0003025482f, 1.18617281e-05f, 2.28877449f },
+	{ 0.965781868f, 0.0042772647f, -0.000266997842f, 1.04679384e-05f, 2.40921855f },
+	{ 0.969802618f, 0.00377467298f, -0.000235624771f, 9.23792322e-06f, 2.53019762f },
+	{ 0.973350883f, 0.00333113712f, -0.000207938123f, 8.15243857e-06f, 2.65164948f },
+	{ 0.976482272f, 0.00293971831f, -0.000183504744f, 7.19450145e-06f, 2.77351809f },
+	{ 0.979245663f, 0.00259429216f, -0.000161942371f, 6.34912521e-06f, 2.89575458f },
+	{ 0.981684387f, 0.00228945492f, -0.000142913646f, 5.60308354e-06f, 3.01831603f },
+	{ 0.983836532f, 0.0020204368f, -0.000126120853f, 4.94470396e-06f, 3.14116383f },
+	{ 0.985735774f, 0.00178302929f, -0.000111301255f, 4.363686e-06f, 3.26426458f },
+	{ 0.987411857f, 0.0015735178f, -9.82230122e-05f, 3.85093927e-06f, 3.3875885f },
+	{ 0.988891006f, 0.00138862454f, -8.66815099e-05f, 3.398442e-06f, 3.51110935f },
+	{ 0.990196347f, 0.00122545683f, -7.64961587e-05f, 2.99911449e-06f, 3.63480401f },
+	{ 0.991348326f, 0.0010814619f, -6.75076226e-05f, 2.64670916e-06f, 3.75865197f },
+	{ 0.992364883f, 0.000954386778f, -5.95752717e-05f, 2.33571268e-06f, 3.88263535f },
+	{ 0.993262053f, 0.000842243375f, -5.25749929e-05f, 2.06125924e-06f, 4.00673819f },
+	{ 0.994053781f, 0.000743277196f, -4.63972683e-05f, 1.81905489e-06f, 4.13094664f },
+	{ 0.994752467f, 0.000655939803f, -4.09454442e-05f, 1.60531033e-06f, 4.25524807f },
+	{ 0.995369077f, 0.000578864827f, -3.61342281e-05f, 1.41668136e-06f, 4.37963104f },
+	{ 0.995913208f, 0.000510846439f, -3.18883431e-05f, 1.25021688e-06f, 4.50408697f },
+	{ 0.996393442f, 0.0004508204f, -2.8141365e-05f, 1.10331257e-06f, 4.6286068f },
+	{ 0.996817231f, 0.000397847587f, -2.48346678e-05f, 9.73669898e-07f, 4.75318289f },
+	{ 0.997191191f, 0.000351099268f, -2.19165177e-05f, 8.59260695e-07f, 4.87780905f },
+	{ 0.997521222f, 0.000309844036f, -1.93412579e-05f, 7.58294902e-07f, 5.00247908f },
+	{ 0.99781251f, 0.000273436395f, -1.70685998e-05f, 6.691929e-07f, 5.12718773f },
+	{ 0.998069525f, 0.00024130677f, -1.50629876e-05f, 5.9056066e-07f, 5.25193071f },
+	{ 0.99829638f, 0.00021295248f, -1.329304e-05f, 5.21167919e-07f, 5.37670374f },
+	{ 0.998496532f, 0.000187929894f, -1.17310665e-05f, 4.59929112e-07f, 5.50150394f },
+	{ 0.998673201f, 0.000165847552f, -1.03526299e-05f, 4.05885999e-07f, 5.62632704f },
+	{ 0.998829126f, 0.000146359947f, -9.1361635e-06f, 3.58193148e-07f, 5.75117111f },
+	{ 0.998966694f, 0.000129162203f, -8.06263597e-06f, 3.16104348e-07f, 5.87603378f },
+	{ 0.999088109f, 0.000113985247f, -7.11525126e-06f, 2.78961096e-07f, 6.00091219f },
+	{ 0.999195278f, 0.000100591627f, -6.27918735e-06f, 2.4618231e-07f, 6.1258049f },
+	{ 0.999289811f, 8.87717979e-05f, -5.54136341e-06f, 2.17255121e-07f, 6.25071049f },
+	{ 0.999373257f, 7.83408395e-05f, -4.89023614e-06f, 1.91726969e-07f, 6.37562704f },
+	{ 0.999446929f, 6.91355453e-05f, -4.3156183e-06f, 1.69198458e-07f, 6.50055361f },
+	{ 0.999511898f, 6.10119059e-05f, -3.80851952e-06f, 1.49317117e-07f, 6.62548828f },
+	{ 0.999569237f, 5.38428176e-05f, -3.36100675e-06f, 1.31771898e-07f, 6.75043106f },
+	{ 0.999619842f, 4.75161214e-05f, -2.966078e-06f, 1.16288291e-07f, 6.87538052f },
+	{ 0.999664545f, 4.1932828e-05f, -2.61755463e-06f, 1.02624057e-07f, 7.00033569f },
+	{ 0.999703944f, 3.70055895e-05f, -2.30998398e-06f, 9.05654076e-08f, 7.12529659f },
+	{ 0.999738753f, 3.26573208e-05f, -2.0385537e-06f, 7.99236943e-08f, 7.25026178f },
+	{ 0.999769449f, 2.88199826e-05f, -1.79901724e-06f, 7.05324084e-08f, 7.37523079f },
+	{ 0.99979651f, 2.54335464e-05f, -1.58762714e-06f, 6.22446379e-08f, 7.50020361f },
+	{ 0.999820411f, 2.2445025e-05f, -1.40107602e-06f, 5.49306982e-08f, 7.62517977f },
+	{ 0.999841511f, 1.9807665e-05f, -1.23644531e-06f, 4.84761706e-08f, 7.75015879f },
+	{ 0.999860168f, 1.74802044e-05f, -1.09115911e-06f, 4.27800693e-08f, 7.87514019f },
+	{ 0.999876618f, 1.54262252e-05f, -9.62944569e-07f, 3.77532778e-08f, 8.00012398f },
+	{ 0.999891102f, 1.36135959e-05f, -8.49795583e-07f, 3.33171535e-08f, 8.12510967f },
+	{ 0.999903917f, 1.20139566e-05f, -7.49941989e-07f, 2.94022833e-08f, 8.25009632f },
+	{ 0.999915183f, 1.0602279e-05f, -6.61821446e-07f, 2.59474238e-08f, 8.37508488f },
+	{ 0.999925137f, 9.35647859e-06f, -5.84055385e-07f, 2.28985222e-08f, 8.50007534f },
+	{ 0.999933958f, 8.2570632e-06f, -5.15427075e-07f, 2.02078745e-08f, 8.62506676f },
+	{ 0.999941707f, 7.2868329e-06f, -4.548628e-07f, 1.78333863e-08f, 8.75005817f },
+	{ 0.999948561f, 6.4306073e-06f, -4.01415008e-07f, 1.57379088e-08f, 8.8750515f },
+	{ 0.999954581f, 5.67499137e-06f, -3.54247504e-07f, 1.38886556e-08f, 9.00004578f },
+	{ 0.999959946f, 5.00816213e-06f, -3.12622319e-07f, 1.22566952e-08f, 9.12504005f },
+	{ 0.999964654f, 4.41968768e-06f, -2.75888226e-07f, 1.08164953e-08f, 9.25003529f },
+	{ 0.999968827f, 3.90036075e-06f, -2.4347051e-07f, 9.54552348e-09f, 9.37503147f },
+	{ 0.999972463f, 3.44205614e-06f, -2.1486197e-07f, 8.42389536e-09f, 9.50002766f },
+	{ 0.999975681f, 3.03760385e-06f, -1.89615022e-07f, 7.43406137e-09f, 9.6250248f },
+	{ 0.999978542f, 2.68067606e-06f, -1.67334676e-07f, 6.56053611e-09f, 9.75002193f },
+	{ 0.999981046f, 2.36568826e-06f, -1.47672324e-07f, 5.7896532e-09f, 9.87501907f },
+	{ 0.999983311f, 2.08771257e-06f, -1.30320373e-07f, 5.10935072e-09f, 10.0000172f },
+	{ 0.999985278f, 1.84239991e-06f, -1.15007325e-07f, 4.50898652e-09f, 10.1250153f },
+	{ 0.999987006f, 1.6259122e-06f, -1.01493612e-07f, 3.97916633e-09f, 10.2500134f },
+	{ 0.999988496f, 1.4348625e-06f, -8.95677985e-08f, 3.5116019e-09f, 10.3750114f },
+	{ 0.999989867f, 1.26626173e-06f, -7.90433035e-08f, 3.09897796e-09f, 10.5000105f },
+	{ 0.999991059f, 1.11747204e-06f, -6.97554725e-08f, 2.73483836e-09f, 10.6250095f },
+	{ 0.999992132f, 9.8616556e-07f, -6.15589855e-08f, 2.41348652e-09f, 10.7500086f },
+	{ 0.999993026f, 8.7028809e-07f, -5.43256142e-08f, 2.12989426e-09f, 10.8750076f },
+};
+
+// Kaiser-windowed halfband FIRs, odd-offset taps: 47 taps beta 7.2, 19 taps
+// beta 8.4, 11 taps beta 6.0
+static const float halfbandCoeffs47[12] = {
+	0.316305757f, -0.100220211f, 0.0542717651f, -0.0331447423f,
+	0.0208015889f, -0.0128857726f, 0.00767792109f, -0.00429897476f,
+	0.00219816365f, -0.00098065217f, 0.00034638535f, -6.82016034e-05f,
+};
+
+static const float halfbandCoeffs19[5] = {
+	0.303149104f, -0.0676601827f, 0.0170102883f, -0.00255927676f, 5.68664691e-05f,
+};
+
+static const float halfbandCoeffs11[3] = {
+	0.285014719f, -0.0359709337f, 0.000946866057f,
+};
+
+// Elliptic polyphase IIR halfbands, allpass coefficients alternating between
+// the branches: 5 sections transition 0.1, 2 sections 0.3, 2 sections 0.4
+static const float halfbandIirCoeffs5[5] = {
+	0.0542307794f, 0.199699581f, 0.398796976f, 0.621096849f, 0.86291784f,
+};
+
+static const float halfbandIirCoeffs2a[2] = {
+	0.124744527f, 0.562584937f,
+};
+
+static const float halfbandIirCoeffs2b[2] = {
+	0.109918959f, 0.536060929f,
+};
+
+#endif // TANGENTS_TABLES_H
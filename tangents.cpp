@@ -18,6 +18,12 @@ GUID: ThTa (Thorinside + Tangents)
 #include <math.h>
 #include <new>
 #include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Constant tables, generated by tools/gentables.cpp at build time
+#include "tangents_tables.h"
 
 // ============================================================================
 // CONSTANTS
@@ -27,13 +33,155 @@ GUID: ThTa (Thorinside + Tangents)
 #define M_PI 3.14159265358979323846f
 #endif
 
+// Per-sample helpers of the block kernels: inlined into the kernels' loops
+// at every optimisation level (GCC keeps them out of line at -Os, and every
+// sample would pay a call)
+#if defined(__GNUC__)
+#define TANGENTS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define TANGENTS_INLINE __forceinline
+#else
+#define TANGENTS_INLINE inline
+#endif
+
 // Default oversampling for initial coefficient calculation
 static const int DEFAULT_OVERSAMPLE = 2;
 
+// Blocks per cycle-statistics window (what the diagnostics display shows)
+static const uint32_t CYCLE_STATS_WINDOW = 128;
+
+// Halfband resampler: one 2x stage per oversampling octave (up to 16x), and
+// the longest stage's number of distinct coefficients
+static const int HALFBAND_MAX_STAGES = 4;
+static const int HALFBAND_MAX_COEFFS = 12;
+
+// Allpass sections of the longest low-latency (IIR) halfband stage
+static const int HALFBAND_IIR_MAX_COEFFS = 5;
+
+// Oversample parameter value of the signal-adaptive setting, and how many
+// blocks Auto waits with lower demand before stepping down one octave
+static const int OVERSAMPLE_AUTO = 5;
+static const int AUTO_OVERSAMPLE_HOLD_BLOCKS = 64;
+
+// CPU governor: blocks with headroom before an octave shed under load comes
+// back, and the fraction of the budget that counts as headroom (one more
+// octave roughly doubles the cost of the oversampled path)
+static const int GOVERNOR_RESTORE_BLOCKS = 256;
+static const float GOVERNOR_HEADROOM = 0.4f;
+
+// Multirate: decimation octaves for low low-pass cutoffs (down to 1/4 rate),
+// the most the Multirate specification allocates
+static const int MULTIRATE_MAX_DEPTH = 2;
+
+// Internal model id passed down the path in place of MS when the Saturator
+// parameter selects the table-driven diode curve
+static const int MODEL_MS_TABLE = 3;
+
+// Scratch floats per frame of the block pipeline besides the oversampled
+// buffer: the base-rate buffer and a second one for Auto's crossfades
+static const int SCRATCH_BASE_FLOATS_PER_FRAME = 2;
+
+// ============================================================================
+// CYCLE COUNTER
+// ============================================================================
+
+#if defined(__arm__) && defined(__ARM_ARCH_7EM__)
+
+// Cortex-M7 DWT cycle counter (hardware build)
+#ifndef TANGENTS_CPU_HZ
+#define TANGENTS_CPU_HZ 600000000u     // disting NT core clock
+#endif
+
+#define DWT_CTRL    (*(volatile uint32_t*)0xE0001000)
+#define DWT_CYCCNT  (*(volatile uint32_t*)0xE0001004)
+#define DWT_LAR     (*(volatile uint32_t*)0xE0001FB0)
+#define SCB_DEMCR   (*(volatile uint32_t*)0xE000EDFC)
+
+static const uint32_t CYCLE_COUNTER_HZ = TANGENTS_CPU_HZ;
+static const char* const CYCLE_UNIT = "cy";
+
+/**
+ * Make sure the DWT cycle counter is running (leaves it alone if the
+ * firmware already enabled it)
+ */
+inline void cycleCounterInit()
+{
+	if (DWT_CTRL & 1u)
+		return;
+	SCB_DEMCR |= (1u << 24);    // TRCENA
+	DWT_LAR = 0xC5ACCE55;       // Unlock DWT on the M7
+	DWT_CYCCNT = 0;
+	DWT_CTRL |= 1u;             // CYCCNTENA
+}
+
+inline uint32_t cycleCounterRead()
+{
+	return DWT_CYCCNT;
+}
+
+#else
+
+// Desktop (nt_emu / host tools / emulation): steady clock in nanoseconds
+#include <chrono>
+
+static const uint32_t CYCLE_COUNTER_HZ = 1000000000u;
+static const char* const CYCLE_UNIT = "ns";
+
+inline void cycleCounterInit()
+{
+}
+
+inline uint32_t cycleCounterRead()
+{
+	return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif
+
 // ============================================================================
 // ALGORITHM DATA STRUCTURES
 // ============================================================================
 
+/**
+ * Delay lines of one 2x halfband stage (interpolator and decimator)
+ *
+ * Each line is stored twice in a row so the newest 2 * HALFBAND_MAX_COEFFS
+ * samples can always be read contiguously from line[pos].
+ */
+struct _tangentsHalfbandStage
+{
+	float up[4 * HALFBAND_MAX_COEFFS];        // base-side input samples
+	float downEven[4 * HALFBAND_MAX_COEFFS];  // oversampled even samples
+	float downOdd[4 * HALFBAND_MAX_COEFFS];   // oversampled odd samples
+	int upPos;
+	int downEvenPos;
+	int downOddPos;
+};
+
+/**
+ * Section states of one low-latency 2x halfband stage: the last input and
+ * output of each first-order allpass section, for the interpolator and the
+ * decimator
+ */
+struct _tangentsHalfbandIirStage
+{
+	float upX[HALFBAND_IIR_MAX_COEFFS];
+	float upY[HALFBAND_IIR_MAX_COEFFS];
+	float downX[HALFBAND_IIR_MAX_COEFFS];
+	float downY[HALFBAND_IIR_MAX_COEFFS];
+};
+
+/**
+ * First-order ADAA memory of one saturator: previous argument and its
+ * antiderivative (0, 0 is a valid pair for every model)
+ */
+struct _tangentsAdaaState
+{
+	float x1;
+	float F1;
+};
+
 /**
  * DTC (Data Tightly Coupled) memory structure
  * Performance-critical filter state goes here for fastest access
@@ -64,6 +212,76 @@ struct _tangentsAlgorithm_DTC
 	// For display
 	float inputLevel;
 	float outputLevel;
+
+	// Halfband resampler state, stage 0 adjoins the base rate; one stage per
+	// octave up to the Max oversample specification, placed after this
+	// structure, NULL if the Halfbands specification leaves it out
+	_tangentsHalfbandStage* halfband;
+	_tangentsHalfbandIirStage* halfbandIir;
+
+	// Substep interpolator history: the last three base-rate inputs, oldest
+	// first
+	float interp[3];
+
+	// Anti-derivative anti-aliasing state of the input and output saturators
+	_tangentsAdaaState adaaIn;
+	_tangentsAdaaState adaaOut;
+
+	// Auto oversampling: octaves in use, blocks of lower demand so far, and
+	// the previous block's peaks into the input saturator and at the output
+	int autoStages;
+	int autoHoldBlocks;
+	float autoPeakIn;
+	float autoPeakOut;
+
+	// CPU governor: octaves shed from the requested factor, blocks with
+	// headroom so far, and the octaves the previous block ran at
+	int governorShed;
+	int governorHoldBlocks;
+	int runStages;
+
+	// Multirate: decimation/interpolation per octave below the sample rate
+	// (up to the Multirate specification, placed after the halfband stages,
+	// NULL if it allows none), octaves in use, and the latest samples into
+	// and out of the decimated path (what newly engaged octaves start from)
+	_tangentsHalfbandIirStage* multirate;
+	int multirateDepth;
+	float multirateIn;
+	float multirateOut;
+};
+
+/**
+ * Execution time of step(), in cycle counter ticks
+ * (CPU cycles on hardware, nanoseconds on desktop builds)
+ *
+ * Accumulated over a window of CYCLE_STATS_WINDOW blocks, then published for
+ * display so the figures track the current load. The peak is kept until the
+ * statistics are reset.
+ */
+struct _tangentsCycleStats
+{
+	// Accumulating window
+	uint32_t windowBlocks;
+	uint32_t windowFrames;
+	uint32_t windowTicks;
+	uint32_t windowBlockMin;
+	uint32_t windowBlockMax;
+	uint32_t windowSampleMin;
+	uint32_t windowSampleMax;
+
+	// Last completed window
+	uint32_t blockMin;
+	uint32_t blockMean;
+	uint32_t blockMax;
+	uint32_t sampleMin;
+	uint32_t sampleMean;
+	uint32_t sampleMax;
+
+	// Worst per-sample cost since reset
+	uint32_t samplePeak;
+
+	// Blocks the CPU governor ran below the requested factor since reset
+	uint32_t degradedBlocks;
 };
 
 /**
@@ -78,6 +296,29 @@ struct _tangentsAlgorithm : public _NT_algorithm
 
 	// Cached computed values
 	float sampleRateRecip;
+
+	// Specifications: octaves of oversampling allocated, which halfband
+	// resamplers, and octaves of multirate decimation
+	int maxStages;
+	int halfbands;
+	int maxMultirateDepth;
+
+	// Block pipeline scratch (DRAM), scratchFrames frames per pass
+	float* scratch;             // base rate
+	float* scratchFade;         // base rate, factor being faded out
+	float* scratchOversampled;  // up to 1 << maxStages
+	int scratchFrames;
+
+	// Halfband history of the factor Auto is fading out (after this
+	// structure, like the DTC's)
+	_tangentsHalfbandStage* fadeHalfband;
+	_tangentsHalfbandIirStage* fadeHalfbandIir;
+
+	// Multirate history of the depth being faded out
+	_tangentsHalfbandIirStage* fadeMultirate;
+
+	// Per-block timing of step()
+	_tangentsCycleStats cycles;
 };
 
 // ============================================================================
@@ -106,11 +347,40 @@ enum
 	// Input control and drive
 	kParamInputAGR,    // Attenu-Gain-Randomizer: CCW=random, 9-12=atten, 12=unity, CW=amplify
 	kParamDrive,
-	kParamOversample,  // 1x, 2x, 4x
+	kParamOversample,  // 1x - 16x, or Auto per block
+
+	// Diagnostics
+	kParamDiagnostics, // Show step() cycle counts in the display
+
+	// Oversampling
+	kParamResampler,   // Hold/average or halfband up/down cascade
+
+	// Anti-aliasing
+	kParamAntialias,   // Saturators plain or with first-order ADAA
+
+	// Multirate
+	kParamMultirate,   // Low-pass at low cutoffs runs at 1/2 or 1/4 rate
+
+	// CPU governor
+	kParamCpuBudget,   // Load of step() above which oversampling is shed, 0=Off
+
+	// Saturator curves
+	kParamSaturator,   // MS diode curve exact (expf) or from a table
 
 	kNumParameters
 };
 
+// Resampler enum
+enum ResamplerType
+{
+	kResamplerHold = 0,
+	kResamplerHalfband,
+	kResamplerHalfbandIir,
+	kResamplerLinear,
+	kResamplerCubic,
+	kNumResamplers
+};
+
 // Filter mode enum
 enum FilterMode
 {
@@ -142,6 +412,34 @@ static char const * const enumStringsOversample[] = {
 	"4x",    // 4x oversampling
 	"8x",    // 8x oversampling
 	"16x",   // 16x oversampling, highest quality
+	"Auto",  // 1x-16x per block, from how hard the saturators are driven
+	NULL
+};
+
+static char const * const enumStringsResampler[] = {
+	"Hold",          // Input held across substeps, output averaged
+	"Halfband",      // Polyphase halfband FIR interpolation and decimation
+	"Halfband IIR",  // Allpass polyphase halfbands, low latency, not linear phase
+	"Linear",        // Input interpolated linearly across substeps, output averaged
+	"Cubic",         // Input through a 4-point Hermite across substeps, output averaged
+	NULL
+};
+
+static char const * const enumStringsAntialias[] = {
+	"Off",
+	"ADAA",      // First-order antiderivative anti-aliasing
+	NULL
+};
+
+static char const * const enumStringsSaturator[] = {
+	"Exact",
+	"Table",     // MS diode curve from a cubic Hermite table
+	NULL
+};
+
+static char const * const enumStringsOffOn[] = {
+	"Off",
+	"On",
 	NULL
 };
 
@@ -168,9 +466,147 @@ static const _NT_parameter parameters[] = {
 	// AGR: 0-25=random, 25-50=atten, 50=unity, 50-100=amplify (+12dB max)
 	{ .name = "Input", .min = 0, .max = 1000, .def = 500, .unit = kNT_unitPercent, .scaling = kNT_scaling10, .enumStrings = NULL },
 	{ .name = "Drive", .min = 0, .max = 1000, .def = 0, .unit = kNT_unitPercent, .scaling = kNT_scaling10, .enumStrings = NULL },
-	{ .name = "Oversample", .min = 0, .max = 4, .def = 1, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = enumStringsOversample },
+	{ .name = "Oversample", .min = 0, .max = OVERSAMPLE_AUTO, .def = 1, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = enumStringsOversample },
+
+	// Diagnostics
+	{ .name = "Diagnostics", .min = 0, .max = 1, .def = 0, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = enumStringsOffOn },
+
+	// Oversampling
+	{ .name = "Resampler", .min = 0, .max = kNumResamplers - 1, .def = 0, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = enumStringsResampler },
+
+	// Anti-aliasing
+	{ .name = "Anti-alias", .min = 0, .max = 1, .def = 0, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = enumStringsAntialias },
+
+	// Multirate
+	{ .name = "Multirate", .min = 0, .max = 1, .def = 0, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = enumStringsOffOn },
+
+	// CPU governor - % of the block deadline, kNT_scaling10 gives 0.1%
+	{ .name = "CPU budget", .min = 0, .max = 1000, .def = 0, .unit = kNT_unitPercent, .scaling = kNT_scaling10, .enumStrings = NULL },
+
+	// Saturator curves
+	{ .name = "Saturator", .min = 0, .max = 1, .def = 0, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = enumStringsSaturator },
+};
+
+// ============================================================================
+// SPECIFICATIONS
+// ============================================================================
+
+enum
+{
+	kSpecMaxOversample,
+	kSpecHalfbands,
+	kSpecMultirate,
+
+	kNumSpecifications
+};
+
+// Halfband resamplers an instance carries state for
+enum
+{
+	kHalfbandsNone = 0,
+	kHalfbandsIir,
+	kHalfbandsAll,
+};
+
+static const _NT_specification specifications[] = {
+	// Octaves: 0=1x ... 4=16x
+	{ .name = "Max oversample", .min = 0, .max = HALFBAND_MAX_STAGES, .def = HALFBAND_MAX_STAGES, .type = kNT_typeGeneric },
+	// 0=none, 1=Halfband IIR, 2=both
+	{ .name = "Halfbands", .min = kHalfbandsNone, .max = kHalfbandsAll, .def = kHalfbandsAll, .type = kNT_typeGeneric },
+	// Decimation octaves: 0=none, 1=1/2 rate, 2=1/4 rate
+	{ .name = "Multirate", .min = 0, .max = MULTIRATE_MAX_DEPTH, .def = MULTIRATE_MAX_DEPTH, .type = kNT_typeGeneric },
+};
+
+/**
+ * Per-instance memory for a set of specifications: the halfband and
+ * multirate stages follow the fixed structures in DTC and SRAM, the scratch
+ * takes one oversampled buffer at the highest factor allowed
+ */
+struct _tangentsMemoryLayout
+{
+	int maxStages;
+	int halfbands;
+	int maxMultirateDepth;
+	uint32_t dtcHalfband;       // offsets, 0 = not allocated
+	uint32_t dtcHalfbandIir;
+	uint32_t dtcMultirate;
+	uint32_t sramHalfband;
+	uint32_t sramHalfbandIir;
+	uint32_t sramMultirate;
+	uint32_t dtc;               // sizes
+	uint32_t sram;
+	uint32_t scratchFloatsPerFrame;
 };
 
+/**
+ * Specification value s, clamped to its range; the default without
+ * specifications (host tools)
+ */
+inline int specificationValue(const int32_t* values, int s)
+{
+	if (!values)
+		return specifications[s].def;
+	int value = values[s];
+	if (value < specifications[s].min) value = specifications[s].min;
+	if (value > specifications[s].max) value = specifications[s].max;
+	return value;
+}
+
+inline void calculateMemoryLayout(_tangentsMemoryLayout* m, const int32_t* values)
+{
+	m->maxStages = specificationValue(values, kSpecMaxOversample);
+	m->halfbands = specificationValue(values, kSpecHalfbands);
+	m->maxMultirateDepth = specificationValue(values, kSpecMultirate);
+
+	// No halfband stages without oversampling
+	int firStages = (m->halfbands == kHalfbandsAll) ? m->maxStages : 0;
+	int iirStages = (m->halfbands != kHalfbandsNone) ? m->maxStages : 0;
+
+	m->dtc = sizeof(_tangentsAlgorithm_DTC);
+	m->dtcHalfband = firStages ? m->dtc : 0;
+	m->dtc += firStages * sizeof(_tangentsHalfbandStage);
+	m->dtcHalfbandIir = iirStages ? m->dtc : 0;
+	m->dtc += iirStages * sizeof(_tangentsHalfbandIirStage);
+	m->dtcMultirate = m->maxMultirateDepth ? m->dtc : 0;
+	m->dtc += m->maxMultirateDepth * sizeof(_tangentsHalfbandIirStage);
+
+	m->sram = sizeof(_tangentsAlgorithm);
+	m->sramHalfband = firStages ? m->sram : 0;
+	m->sram += firStages * sizeof(_tangentsHalfbandStage);
+	m->sramHalfbandIir = iirStages ? m->sram : 0;
+	m->sram += iirStages * sizeof(_tangentsHalfbandIirStage);
+	m->sramMultirate = m->maxMultirateDepth ? m->sram : 0;
+	m->sram += m->maxMultirateDepth * sizeof(_tangentsHalfbandIirStage);
+
+	m->scratchFloatsPerFrame = SCRATCH_BASE_FLOATS_PER_FRAME + (1 << m->maxStages);
+}
+
+/**
+ * The resampler in effect: one whose halfband stages the specifications
+ * left out runs as Hold
+ */
+inline int activeResampler(const _tangentsAlgorithm* pThis)
+{
+	int resampler = pThis->v[kParamResampler];
+	if ((resampler == kResamplerHalfband && !pThis->dtc->halfband) ||
+	    (resampler == kResamplerHalfbandIir && !pThis->dtc->halfbandIir))
+		return kResamplerHold;
+	return resampler;
+}
+
+/**
+ * Oversampling octaves asked for: the parameter up to the Max oversample
+ * specification, or Auto's choice for the current block (the CPU governor
+ * may run fewer, see _tangentsAlgorithm_DTC::runStages)
+ */
+inline int activeOversampleStages(const _tangentsAlgorithm* pThis)
+{
+	int stages = pThis->v[kParamOversample];
+	if (stages == OVERSAMPLE_AUTO)
+		return pThis->dtc->autoStages;
+	return (stages > pThis->maxStages) ? pThis->maxStages : stages;
+}
+
 // ============================================================================
 // PARAMETER PAGES
 // ============================================================================
@@ -180,7 +616,11 @@ static const uint8_t pageFilter[] = {
 	kParamResonance,
 	kParamMode,
 	kParamModel,
+	kParamSaturator,
 	kParamOversample,
+	kParamResampler,
+	kParamAntialias,
+	kParamMultirate,
 };
 
 static const uint8_t pageInput[] = {
@@ -201,11 +641,17 @@ static const uint8_t pageRouting[] = {
 	kParamOutputMode,
 };
 
+static const uint8_t pageDiagnostics[] = {
+	kParamDiagnostics,
+	kParamCpuBudget,
+};
+
 static const _NT_parameterPage pages[] = {
 	{ .name = "Filter", .numParams = ARRAY_SIZE(pageFilter), .params = pageFilter },
 	{ .name = "Input", .numParams = ARRAY_SIZE(pageInput), .params = pageInput },
 	{ .name = "CV", .numParams = ARRAY_SIZE(pageCV), .params = pageCV },
 	{ .name = "Routing", .numParams = ARRAY_SIZE(pageRouting), .params = pageRouting },
+	{ .name = "Diagnostics", .numParams = ARRAY_SIZE(pageDiagnostics), .params = pageDiagnostics },
 };
 
 static const _NT_parameterPages parameterPages = {
@@ -217,15 +663,53 @@ static const _NT_parameterPages parameterPages = {
 // HELPER FUNCTIONS
 // ============================================================================
 
+/**
+ * Minimum and maximum as a compare and select, (a < b) ? a : b and
+ * (a > b) ? a : b, so a NaN a gives b. On x86 they are the minss/maxss
+ * intrinsics: GCC turns the plain ternary back into compare-and-jump once a
+ * constant clamp is inlined into a loop, at -Os as well as -O2. Other
+ * targets get the ternary and the compiler's choice.
+ */
+inline float minSelect(float a, float b)
+{
+#if defined(__SSE2__)
+	return _mm_cvtss_f32(_mm_min_ss(_mm_set_ss(a), _mm_set_ss(b)));
+#else
+	return (a < b) ? a : b;
+#endif
+}
+
+inline float maxSelect(float a, float b)
+{
+#if defined(__SSE2__)
+	return _mm_cvtss_f32(_mm_max_ss(_mm_set_ss(a), _mm_set_ss(b)));
+#else
+	return (a > b) ? a : b;
+#endif
+}
+
+/**
+ * (x > t) ? a : b as a mask select on x86 (cmpss, and, andnot, or), for the
+ * selects between constants that the compiler would otherwise branch on
+ */
+inline float selectGreater(float x, float t, float a, float b)
+{
+#if defined(__SSE2__)
+	__m128 mask = _mm_cmpgt_ss(_mm_set_ss(x), _mm_set_ss(t));
+	return _mm_cvtss_f32(_mm_or_ps(_mm_and_ps(mask, _mm_set_ss(a)), _mm_andnot_ps(mask, _mm_set_ss(b))));
+#else
+	return (x > t) ? a : b;
+#endif
+}
+
 /**
  * Fast tanh approximation for Steiner-Parker non-linearity
  * Based on rational approximation, accurate to ~0.001 for |x| < 3
  */
-inline float fastTanh(float x)
+TANGENTS_INLINE float fastTanh(float x)
 {
-	// Clamp to avoid overflow
-	if (x > 3.0f) return 1.0f;
-	if (x < -3.0f) return -1.0f;
+	// Clamp to avoid overflow; the rational is exactly ±1 at ±3
+	x = minSelect(maxSelect(x, -3.0f), 3.0f);
 
 	float x2 = x * x;
 	return x * (27.0f + x2) / (27.0f + 9.0f * x2);
@@ -235,29 +719,72 @@ inline float fastTanh(float x)
  * Diode clipping approximation for MS model
  * Asymmetric soft clipping characteristic
  */
-inline float diodeClip(float x)
+TANGENTS_INLINE float diodeClip(float x)
 {
-	// Asymmetric clipping: harder on positive, softer on negative
-	if (x > 0.0f)
-		return 1.0f - expf(-x);
-	else
-		return -0.5f * (1.0f - expf(2.0f * x));
+	// Asymmetric clipping: harder on positive (1 - e^-x), softer on negative
+	// (-0.5 (1 - e^2x)); the exponent is whichever of -x, 2x is smaller
+	float scale = selectGreater(x, 0.0f, 1.0f, -0.5f);
+	return scale * (1.0f - expf(minSelect(-x, 2.0f * x)));
 }
 
 /**
  * Aggressive saturation for XX model
  * Hard clipping with fold-back
  */
-inline float aggressiveSat(float x)
+TANGENTS_INLINE float aggressiveSat(float x)
 {
-	// Fold-back distortion for aggressive sound
+	// Fold-back distortion for aggressive sound: above 0.8 the magnitude
+	// folds back to 0.8 - (|x| - 0.8) / 2, which is below |x| exactly there
 	x = fastTanh(x * 2.0f);
-	if (fabsf(x) > 0.8f)
-	{
-		float excess = fabsf(x) - 0.8f;
-		x = (x > 0 ? 1.0f : -1.0f) * (0.8f - excess * 0.5f);
-	}
-	return x;
+	float a = fabsf(x);
+	return copysignf(minSelect(a, 0.8f - (a - 0.8f) * 0.5f), x);
+}
+
+/**
+ * Below this input step first-order ADAA evaluates the saturator at the
+ * midpoint instead of dividing antiderivative differences, which cancel in
+ * float; the midpoint error there is about step^2/24 * f''
+ */
+static const float ADAA_EPSILON = 1e-3f;
+
+/**
+ * Antiderivative of fastTanh, zero at x = 0:
+ * x^2/18 + 4/3 ln(1 + x^2/3) inside ±3, linear (slope ±1) beyond
+ */
+TANGENTS_INLINE float fastTanhAntiderivative(float x)
+{
+	float a = fabsf(x);
+	float c = minSelect(a, 3.0f);
+
+	float x2 = c * c;
+	return x2 * (1.0f / 18.0f) + (4.0f / 3.0f) * log1pf(x2 * (1.0f / 3.0f)) + (a - c);
+}
+
+/**
+ * Antiderivative of diodeClip, zero at x = 0:
+ * x + expm1(-x) above 0, -x/2 + expm1(2x)/4 below
+ */
+TANGENTS_INLINE float diodeClipAntiderivative(float x)
+{
+	float slope = selectGreater(x, 0.0f, 1.0f, -0.5f);
+	float scale = selectGreater(x, 0.0f, 1.0f, 0.25f);
+	return slope * x + scale * expm1f(minSelect(-x, 2.0f * x));
+}
+
+/**
+ * Antiderivative of aggressiveSat, zero at x = 0. The fold starts where
+ * fastTanh(2x) = 0.8, at 2x = 1.0520011; beyond it the slope is
+ * 1.2 - 0.5 fastTanh(2x). Both pieces are evaluated and one selected.
+ */
+TANGENTS_INLINE float aggressiveSatAntiderivative(float x)
+{
+	const float foldW = 1.0520011f;
+	const float foldG = 0.480162372f;      // fastTanhAntiderivative(foldW)
+
+	float a = fabsf(x);
+	float g = fastTanhAntiderivative(2.0f * a);
+	float folded = 0.5f * foldG + 1.2f * (a - 0.5f * foldW) - 0.25f * (g - foldG);
+	return selectGreater(a, 0.5f * foldW, folded, 0.5f * g);
 }
 
 /**
@@ -271,7 +798,7 @@ inline float dbToLinear(float db)
 /**
  * Sanitize float - returns 0 if NaN or infinity
  */
-inline float sanitize(float x)
+TANGENTS_INLINE float sanitize(float x)
 {
 	// Check for NaN or infinity
 	if (x != x || x > 1e10f || x < -1e10f)
@@ -279,17 +806,205 @@ inline float sanitize(float x)
 	return x;
 }
 
+/**
+ * Below this magnitude (-300 dB) flushDenormal() returns 0. The product of
+ * any two values above it is still a normal float, which a floor just above
+ * FLT_MIN (1.2e-38) would not give the saturators' squares.
+ */
+static const float DENORMAL_FLOOR = 1e-15f;
+
+/**
+ * Flush near-zero values to 0, so that near-silent input and decaying state
+ * never take the arithmetic into subnormal floats (each subnormal result or
+ * operand costs a microcode assist on x86 hosts, tens of times a normal one)
+ */
+TANGENTS_INLINE float flushDenormal(float x)
+{
+	return selectGreater(fabsf(x), DENORMAL_FLOOR, x, 0.0f);
+}
+
+/**
+ * flushDenormal() over n values in place
+ */
+inline void flushDenormalBlock(float* x, int n)
+{
+	for (int i = 0; i < n; ++i)
+		x[i] = flushDenormal(x[i]);
+}
+
+/**
+ * On SSE hosts, set flush-to-zero and denormals-are-zero for the length of
+ * step(), returning the previous control word for floatModeRestore().
+ * flushDenormal() keeps subnormals out of the input and out of the state
+ * between blocks; this covers what decays through the range within a block
+ * (a highpass settling on DC, say). Hardware builds leave the FPSCR as the
+ * firmware set it.
+ */
+inline uint32_t floatModeFlushToZero()
+{
+#if defined(__SSE2__)
+	uint32_t csr = _mm_getcsr();
+	_mm_setcsr(csr | 0x8040u);     // FTZ | DAZ
+	return csr;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Put back the control word floatModeFlushToZero() returned
+ */
+inline void floatModeRestore(uint32_t csr)
+{
+#if defined(__SSE2__)
+	_mm_setcsr(csr);
+#else
+	(void)csr;
+#endif
+}
+
 /**
  * Soft clamp to prevent filter runaway
  * Uses tanh-like soft limiting at ±10
  */
 inline float softClamp(float x, float limit = 10.0f)
 {
-	if (x > limit) return limit;
-	if (x < -limit) return -limit;
-	return x;
+	return minSelect(maxSelect(x, -limit), limit);
+}
+
+// ============================================================================
+// TABLES
+// ============================================================================
+
+/*
+Lookups into the constant tables of tangents_tables.h, which the build
+generates (tools/gentables.cpp) and `make tables` checks against their
+references (tools/tables.cpp). They live in read-only data; nothing is
+computed at load or construction.
+
+Prewarp: g = tan(pi r) at r = fc / fs in steps of 1/4096 up to the 0.45
+clamp of calculateFilterCoeffs, read with linear interpolation. Indexed by
+the ratio, one table serves every oversample factor, multirate depth and
+sample rate. Relative error below 6e-6 (at the top of the range; 2e-7 at
+low cutoffs).
+
+exp2: 2^x over ±10 octaves as a whole octave times the fraction from a
+table of 1/256 octave steps, linearly interpolated; relative error below
+1.1e-6 (0.002 cents).
+
+Diode curve: a cubic Hermite through diodeClip's values and slopes at nodes
+every 1/8 over [-6, 12], stored per interval as the polynomial in the
+position u within it, along with the antiderivative of the interpolant at
+the interval's start (so ADAA differentiates exactly what plain saturation
+evaluates). Outside the table the end values continue flat, where the
+reference is within 6e-6 of its asymptotes. Maximum error against diodeClip
+(float, within 4.5e-8 of exact): 4.5e-6 inside the table, 6.1e-6 (-104 dB)
+in the tails. The antiderivative is within 1.9e-6 of
+diodeClipAntiderivative inside the table, and beyond it its slope is within
+6.1e-6 (what ADAA's differences see).
+*/
+
+/**
+ * g = tan(pi r) from the prewarp table, r clamped to [0, 0.45]
+ */
+inline float prewarp(float r)
+{
+	r = (r > 0.0f) ? r : 0.0f;
+	r = (r < 0.45f) ? r : 0.45f;
+	float t = r * PREWARP_TABLE_RESOLUTION;
+	int i = (int)t;
+	float u = t - (float)i;
+	const float* p = &prewarpTable[i];
+	return p[0] + u * (p[1] - p[0]);
+}
+
+/**
+ * 2^x from the exp2 tables, x clamped to ±EXP2_TABLE_OCTAVES
+ */
+inline float exp2Table(float x)
+{
+	const float top = (float)EXP2_TABLE_OCTAVES;
+	x = (x > -top) ? x : -top;
+	x = (x < top) ? x : top;
+	float t = (x + top) * (float)EXP2_TABLE_RESOLUTION;
+	int i = (int)t;
+	float u = t - (float)i;
+	int octave = i / EXP2_TABLE_RESOLUTION;
+	const float* f = &exp2FractionTable[i - octave * EXP2_TABLE_RESOLUTION];
+	return exp2OctaveTable[octave] * (f[0] + u * (f[1] - f[0]));
+}
+
+/**
+ * Interval of the diode table holding x (clamped to the table, a NaN at the
+ * start), with the clamped x and the position within the interval
+ */
+TANGENTS_INLINE const _tangentsSaturatorInterval* diodeTableInterval(float x, float* xc, float* u)
+{
+	float c = minSelect(maxSelect(x, DIODE_TABLE_MIN), DIODE_TABLE_MAX);
+	int i = (int)((c - DIODE_TABLE_MIN) * DIODE_TABLE_RESOLUTION);
+	i = (i < DIODE_TABLE_INTERVALS - 1) ? i : DIODE_TABLE_INTERVALS - 1;
+	*xc = c;
+	*u = (c - (DIODE_TABLE_MIN + (float)i * (1.0f / DIODE_TABLE_RESOLUTION))) * DIODE_TABLE_RESOLUTION;
+	return &diodeTable[i];
+}
+
+/**
+ * diodeClip from the table: no transcendental calls
+ */
+TANGENTS_INLINE float diodeClipTable(float x)
+{
+	float xc, u;
+	const _tangentsSaturatorInterval* t = diodeTableInterval(x, &xc, &u);
+	return t->c0 + u * (t->c1 + u * (t->c2 + u * t->c3));
+}
+
+/**
+ * Antiderivative of diodeClipTable, zero at x = 0: the interval's value plus
+ * the integral of its cubic up to x, linear beyond the table
+ */
+TANGENTS_INLINE float diodeClipTableAntiderivative(float x)
+{
+	float xc, u;
+	const _tangentsSaturatorInterval* t = diodeTableInterval(x, &xc, &u);
+	float integral = u * (t->c0 + u * (0.5f * t->c1 + u * ((1.0f / 3.0f) * t->c2 + u * 0.25f * t->c3)));
+	float yc = t->c0 + u * (t->c1 + u * (t->c2 + u * t->c3));
+	return t->F + integral * (1.0f / DIODE_TABLE_RESOLUTION) + (x - xc) * yc;
 }
 
+// ============================================================================
+// GUARD INSTRUMENTATION
+// ============================================================================
+
+// Host tools (tools/fuzz.cpp) define TANGENTS_GUARD_STATS to count how often
+// the safety guards in step() actually change a value. Plugin builds compile
+// the checks away.
+#ifdef TANGENTS_GUARD_STATS
+
+struct _tangentsGuardStats
+{
+	uint32_t clampBp;           // bp beyond the ±5 state clamp
+	uint32_t clampLp;           // lp beyond the ±5 state clamp
+	uint32_t sanitizeBp;        // non-finite / huge bp zeroed
+	uint32_t sanitizeLp;
+	uint32_t sanitizeHp;
+	uint32_t sanitizeOutput;    // non-finite / huge output zeroed
+	uint32_t sanitizeInput;     // non-finite / huge input zeroed
+};
+
+_tangentsGuardStats tangentsGuardStats;
+
+#define GUARD_COUNT_CLAMP(counter, x, limit) \
+	do { if ((x) > (limit) || (x) < -(limit)) ++tangentsGuardStats.counter; } while (0)
+#define GUARD_COUNT_SANITIZE(counter, x) \
+	do { if (sanitize(x) != (x)) ++tangentsGuardStats.counter; } while (0)
+
+#else
+
+#define GUARD_COUNT_CLAMP(counter, x, limit) do { } while (0)
+#define GUARD_COUNT_SANITIZE(counter, x) do { } while (0)
+
+#endif
+
 /**
  * Fast xorshift random number generator
  * Returns value in range [0.0, 1.0]
@@ -348,8 +1063,9 @@ inline void calculateFilterCoeffs(_tangentsAlgorithm_DTC* dtc, float cutoff, flo
 	if (cutoff < 20.0f) cutoff = 20.0f;
 	if (cutoff > sampleRate * 0.45f) cutoff = sampleRate * 0.45f;
 
-	// Pre-warped frequency coefficient: g = tan(π * fc / fs)
-	float g = tanf(M_PI * cutoff / sampleRate);
+	// Pre-warped frequency coefficient: g = tan(π * fc / fs), from the
+	// shared table
+	float g = prewarp(cutoff / sampleRate);
 
 	// Damping coefficient k: controls resonance
 	// k = 2 means no resonance (critically damped)
@@ -363,20 +1079,1247 @@ inline void calculateFilterCoeffs(_tangentsAlgorithm_DTC* dtc, float cutoff, flo
 }
 
 // ============================================================================
-// FACTORY FUNCTIONS
+// OVERSAMPLED TRANSITION
 // ============================================================================
 
-void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* specifications)
+/**
+ * All `oversample` SVF substeps of one sample as a single linear map
+ *
+ * The saturated input u is held across the substeps and the coefficients are
+ * fixed for the block, so as long as no softClamp fires the substeps compose
+ * to s' = A s + B u on the state s = (bp, lp), the averaged mode output to
+ * y = C s + D u and the last substep's highpass to hp = H s + Hu u. Cost per
+ * sample is then the same at 16x as at 1x.
+ *
+ * stateGain and inputGain bound every intermediate state:
+ * |s_j| <= stateGain * max(|bp|, |lp|) + inputGain * |u| for all substeps,
+ * which step() uses to decide when the clamps cannot fire.
+ */
+struct _tangentsSvfTransition
 {
-	req.numParameters = ARRAY_SIZE(parameters);
-	req.sram = sizeof(_tangentsAlgorithm);
-	req.dram = 0;  // No large buffers needed
-	req.dtc = sizeof(_tangentsAlgorithm_DTC);
-	req.itc = 0;
-}
+	float a00, a01, a10, a11;   // state transition (bp, lp)
+	float b0, b1;               // input to state
+	float c0, c1, d;            // averaged mode output
+	float h0, h1, hu;           // highpass of the last substep
+	float stateGain;
+	float inputGain;
+};
 
-_NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs,
-                        const _NT_algorithmRequirements& req,
+/**
+ * Compose the substeps of one sample for the current coefficients
+ */
+inline void calculateSvfTransition(_tangentsSvfTransition* t, const _tangentsAlgorithm_DTC* dtc, FilterMode mode, int oversample)
+{
+	const float g = dtc->g;
+	const float k = dtc->k;
+	const float gInv = dtc->gInv;
+
+	// One substep as rows over (bp, lp, u)
+	const float hpS0 = -k * gInv, hpS1 = -gInv, hpU = gInv;
+	const float bpS0 = 1.0f + g * hpS0, bpS1 = g * hpS1, bpU = g * hpU;
+	const float lpS0 = g * bpS0, lpS1 = 1.0f + g * bpS1, lpU = g * bpU;
+
+	float cS0, cS1, cU;
+	switch (mode)
+	{
+		case kFilterModeBandpass: cS0 = bpS0; cS1 = bpS1; cU = bpU; break;
+		case kFilterModeHighpass: cS0 = hpS0; cS1 = hpS1; cU = hpU; break;
+		case kFilterModeAllpass:  cS0 = lpS0 - hpS0; cS1 = lpS1 - hpS1; cU = lpU - hpU; break;
+		default:                  cS0 = lpS0; cS1 = lpS1; cU = lpU; break;
+	}
+
+	// s_j = M s + v u before substep j
+	float m00 = 1.0f, m01 = 0.0f, m10 = 0.0f, m11 = 1.0f;
+	float v0 = 0.0f, v1 = 0.0f;
+	float c0 = 0.0f, c1 = 0.0f, d = 0.0f;
+	float stateGain = 0.0f, inputGain = 0.0f;
+
+	for (int j = 0; j < oversample; ++j)
+	{
+		c0 += cS0 * m00 + cS1 * m10;
+		c1 += cS0 * m01 + cS1 * m11;
+		d += cS0 * v0 + cS1 * v1 + cU;
+
+		if (j == oversample - 1)
+		{
+			t->h0 = hpS0 * m00 + hpS1 * m10;
+			t->h1 = hpS0 * m01 + hpS1 * m11;
+			t->hu = hpS0 * v0 + hpS1 * v1 + hpU;
+		}
+
+		float n00 = bpS0 * m00 + bpS1 * m10;
+		float n01 = bpS0 * m01 + bpS1 * m11;
+		float n10 = lpS0 * m00 + lpS1 * m10;
+		float n11 = lpS0 * m01 + lpS1 * m11;
+		float w0 = bpS0 * v0 + bpS1 * v1 + bpU;
+		float w1 = lpS0 * v0 + lpS1 * v1 + lpU;
+		m00 = n00; m01 = n01; m10 = n10; m11 = n11;
+		v0 = w0; v1 = w1;
+
+		float rowGain = fmaxf(fabsf(m00) + fabsf(m01), fabsf(m10) + fabsf(m11));
+		float rowInput = fmaxf(fabsf(v0), fabsf(v1));
+		if (rowGain > stateGain) stateGain = rowGain;
+		if (rowInput > inputGain) inputGain = rowInput;
+	}
+
+	float scale = 1.0f / (float)oversample;
+	t->a00 = m00; t->a01 = m01; t->a10 = m10; t->a11 = m11;
+	t->b0 = v0; t->b1 = v1;
+	t->c0 = c0 * scale; t->c1 = c1 * scale; t->d = d * scale;
+	t->stateGain = stateGain;
+	t->inputGain = inputGain;
+}
+
+// ============================================================================
+// HALFBAND RESAMPLER
+// ============================================================================
+
+/*
+Kaiser-windowed halfband FIRs with a centre tap of exactly 0.5 (generated,
+tangents_tables.h). Only the odd-offset taps are stored (a_i at offsets
+±(2i - 1) from the centre); all other taps are zero. Edges are relative to
+the stage's higher rate. Each stage only has to protect the band that
+survives the stages nearer the base rate, so the transition widens and the
+filters shorten as the rate goes up:
+
+  stage 0 (1x <-> 2x)    47 taps  beta 7.2  pass 0.20  stop 0.30  -72 dB
+  stage 1 (2x <-> 4x)    19 taps  beta 8.4  pass 0.10  stop 0.40  -83 dB
+  stage 2+ (4x <-> 16x)  11 taps  beta 6.0  pass 0.05  stop 0.45  -70 dB
+*/
+struct _tangentsHalfbandDesign
+{
+	const float* coeffs;
+	int numCoeffs;
+};
+
+static const _tangentsHalfbandDesign halfbandDesigns[HALFBAND_MAX_STAGES] = {
+	{ halfbandCoeffs47, ARRAY_SIZE(halfbandCoeffs47) },
+	{ halfbandCoeffs19, ARRAY_SIZE(halfbandCoeffs19) },
+	{ halfbandCoeffs11, ARRAY_SIZE(halfbandCoeffs11) },
+	{ halfbandCoeffs11, ARRAY_SIZE(halfbandCoeffs11) },
+};
+
+/*
+Low-latency alternative: polyphase IIR halfbands, H(z) = (A0(z^2) +
+z^-1 A1(z^2)) / 2, where A0 and A1 are cascades of first-order allpass
+sections (a + z^-1) / (1 + a z^-1) at the lower rate. Coefficients alternate
+between the branches, A0 first. They are designed for the same edges as the
+FIRs (elliptic, Valenzuela-Constantinides, generated from the transition
+width in tangents_tables.h), at the cost of a group delay that rises towards
+the band edge rather than staying flat:
+
+  stage 0 (1x <-> 2x)    5 sections  stop 0.30  -87 dB  2.80 samples at DC
+  stage 1 (2x <-> 4x)    2 sections  stop 0.40  -73 dB  1.56
+  stage 2+ (4x <-> 16x)  2 sections  stop 0.45  -104 dB 1.60
+
+(group delay per filter, in samples of the stage's higher rate)
+*/
+struct _tangentsHalfbandIirDesign
+{
+	const float* coeffs;
+	int numCoeffs;
+};
+
+static const _tangentsHalfbandIirDesign halfbandIirDesigns[HALFBAND_MAX_STAGES] = {
+	{ halfbandIirCoeffs5, ARRAY_SIZE(halfbandIirCoeffs5) },
+	{ halfbandIirCoeffs2a, ARRAY_SIZE(halfbandIirCoeffs2a) },
+	{ halfbandIirCoeffs2b, ARRAY_SIZE(halfbandIirCoeffs2b) },
+	{ halfbandIirCoeffs2b, ARRAY_SIZE(halfbandIirCoeffs2b) },
+};
+
+/**
+ * Design of stage s, for the stage type
+ */
+inline const _tangentsHalfbandDesign& halfbandDesign(const _tangentsHalfbandStage*, int s)
+{
+	return halfbandDesigns[s];
+}
+
+inline const _tangentsHalfbandIirDesign& halfbandDesign(const _tangentsHalfbandIirStage*, int s)
+{
+	return halfbandIirDesigns[s];
+}
+
+/**
+ * Push x into a mirrored delay line of length len; afterwards line[pos + j]
+ * is the j-th most recent sample
+ */
+inline void halfbandPush(float* line, int& pos, int len, float x)
+{
+	pos = (pos == 0 ? len : pos) - 1;
+	line[pos] = x;
+	line[pos + len] = x;
+}
+
+/**
+ * Interpolate by 2: one input sample in, two output samples out (polyphase,
+ * the even phase is a pure delay of numCoeffs samples)
+ */
+inline void halfbandInterpolate(_tangentsHalfbandStage* st, const _tangentsHalfbandDesign& d, float x, float* out)
+{
+	const int n = d.numCoeffs;
+	halfbandPush(st->up, st->upPos, 2 * n, x);
+	const float* h = st->up + st->upPos;
+
+	float odd = 0.0f;
+	for (int i = 1; i <= n; ++i)
+		odd += d.coeffs[i - 1] * (h[n - i] + h[n - 1 + i]);
+
+	out[0] = h[n];
+	out[1] = 2.0f * odd;
+}
+
+/**
+ * Decimate by 2: two input samples in (x0 first), one output sample out
+ */
+inline float halfbandDecimate(_tangentsHalfbandStage* st, const _tangentsHalfbandDesign& d, float x0, float x1)
+{
+	const int n = d.numCoeffs;
+	halfbandPush(st->downEven, st->downEvenPos, 2 * n, x0);
+	halfbandPush(st->downOdd, st->downOddPos, n + 1, x1);
+	const float* e = st->downEven + st->downEvenPos;
+	const float* o = st->downOdd + st->downOddPos;
+
+	float y = 0.5f * o[n];
+	for (int i = 1; i <= n; ++i)
+		y += d.coeffs[i - 1] * (e[n - i] + e[n - 1 + i]);
+	return y;
+}
+
+/**
+ * Interpolate by 2 through the allpass branches: A0 gives the even output
+ * sample, A1 the odd one
+ */
+inline void halfbandInterpolate(_tangentsHalfbandIirStage* st, const _tangentsHalfbandIirDesign& d, float x, float* out)
+{
+	float branch[2] = { x, x };
+	for (int i = 0; i < d.numCoeffs; ++i)
+	{
+		float& v = branch[i & 1];
+		float y = d.coeffs[i] * (v - st->upY[i]) + st->upX[i];
+		st->upX[i] = v;
+		st->upY[i] = y;
+		v = y;
+	}
+	out[0] = branch[0];
+	out[1] = branch[1];
+}
+
+/**
+ * Decimate by 2 through the allpass branches (x0 first): A0 takes the later
+ * sample, A1 the earlier one
+ */
+inline float halfbandDecimate(_tangentsHalfbandIirStage* st, const _tangentsHalfbandIirDesign& d, float x0, float x1)
+{
+	float branch[2] = { x1, x0 };
+	for (int i = 0; i < d.numCoeffs; ++i)
+	{
+		float& v = branch[i & 1];
+		float y = d.coeffs[i] * (v - st->downY[i]) + st->downX[i];
+		st->downX[i] = v;
+		st->downY[i] = y;
+		v = y;
+	}
+	return 0.5f * (branch[0] + branch[1]);
+}
+
+/**
+ * Upsample one base-rate sample through `stages` 2x stages into
+ * 1 << stages samples
+ */
+template <class Stage>
+inline void halfbandUpsample(Stage* stages, int numStages, float x, float* out)
+{
+	float scratch[1 << HALFBAND_MAX_STAGES];
+	out[0] = x;
+	for (int s = 0, n = 1; s < numStages; ++s, n *= 2)
+	{
+		for (int i = 0; i < n; ++i)
+			scratch[i] = out[i];
+		for (int i = 0; i < n; ++i)
+			halfbandInterpolate(&stages[s], halfbandDesign(stages, s), scratch[i], out + 2 * i);
+	}
+}
+
+/**
+ * Decimate 1 << stages oversampled samples back to one base-rate sample
+ * (x is overwritten)
+ */
+template <class Stage>
+inline float halfbandDownsample(Stage* stages, int numStages, float* x)
+{
+	for (int s = numStages - 1, n = 1 << (numStages - 1); s >= 0; --s, n /= 2)
+	{
+		for (int i = 0; i < n; ++i)
+			x[i] = halfbandDecimate(&stages[s], halfbandDesign(stages, s), x[2 * i], x[2 * i + 1]);
+	}
+	return x[0];
+}
+
+/**
+ * Group delay of the up/down cascade for 1 << stages, in base-rate samples
+ */
+inline float halfbandLatency(const _tangentsHalfbandStage*, int numStages)
+{
+	float latency = 0.0f;
+	for (int s = 0; s < numStages; ++s)
+	{
+		float n = (float)halfbandDesigns[s].numCoeffs;
+		latency += (n + (2.0f * n - 1.0f) * 0.5f) / (float)(1 << s);
+	}
+	return latency;
+}
+
+/**
+ * Group delay at DC of one low-latency stage's interpolator and decimator
+ * together, in samples of its higher rate. Each section a delays by
+ * 2 (1 - a) / (1 + a); the interpolator delays by the mean of its branches
+ * with A1 one sample later, the decimator by one sample less, as A0 reads
+ * the later input.
+ */
+inline float halfbandIirDelay(const _tangentsHalfbandIirDesign& d)
+{
+	float delay = 0.0f;
+	for (int i = 0; i < d.numCoeffs; ++i)
+		delay += 2.0f * (1.0f - d.coeffs[i]) / (1.0f + d.coeffs[i]);
+	return delay;
+}
+
+/**
+ * Group delay of the low-latency cascade at DC, in base-rate samples
+ */
+inline float halfbandLatency(const _tangentsHalfbandIirStage*, int numStages)
+{
+	float latency = 0.0f;
+	for (int s = 0; s < numStages; ++s)
+		latency += halfbandIirDelay(halfbandIirDesigns[s]) / (float)(2 << s);
+	return latency;
+}
+
+/**
+ * Switch stages from..to-1 in behind the current top stage (from > 0),
+ * with histories filled at the levels the top stage last saw, so that they
+ * start near their steady state rather than from silence
+ */
+inline void halfbandExtend(_tangentsHalfbandStage* stages, int from, int to)
+{
+	const _tangentsHalfbandStage* top = &stages[from - 1];
+	float up = top->up[top->upPos + halfbandDesigns[from - 1].numCoeffs - 1];  // its latest output
+	float down = top->downOdd[top->downOddPos];                               // latest oversampled input
+
+	for (int s = from; s < to; ++s)
+	{
+		_tangentsHalfbandStage* st = &stages[s];
+		for (int i = 0; i < 4 * HALFBAND_MAX_COEFFS; ++i)
+		{
+			st->up[i] = up;
+			st->downEven[i] = down;
+			st->downOdd[i] = down;
+		}
+		st->upPos = 0;
+		st->downEvenPos = 0;
+		st->downOddPos = 0;
+	}
+}
+
+/**
+ * Low-latency counterpart: every section state of the new stages at the
+ * top stage's latest input levels
+ */
+inline void halfbandExtend(_tangentsHalfbandIirStage* stages, int from, int to)
+{
+	const _tangentsHalfbandIirStage* top = &stages[from - 1];
+	float up = top->upX[0];       // latest input
+	float down = top->downX[0];   // latest oversampled input
+
+	for (int s = from; s < to; ++s)
+	{
+		_tangentsHalfbandIirStage* st = &stages[s];
+		for (int i = 0; i < HALFBAND_IIR_MAX_COEFFS; ++i)
+		{
+			st->upX[i] = st->upY[i] = up;
+			st->downX[i] = st->downY[i] = down;
+		}
+	}
+}
+
+/**
+ * Flush the delay lines of stages 0..numStages-1 below DENORMAL_FLOOR to
+ * zero (both copies of every sample alike, so the lines stay mirrored)
+ */
+inline void halfbandFlush(_tangentsHalfbandStage* stages, int numStages)
+{
+	for (int s = 0; s < numStages; ++s)
+	{
+		flushDenormalBlock(stages[s].up, 4 * HALFBAND_MAX_COEFFS);
+		flushDenormalBlock(stages[s].downEven, 4 * HALFBAND_MAX_COEFFS);
+		flushDenormalBlock(stages[s].downOdd, 4 * HALFBAND_MAX_COEFFS);
+	}
+}
+
+/**
+ * Low-latency counterpart: the section states, which would otherwise decay
+ * through the subnormal range after the input stops
+ */
+inline void halfbandFlush(_tangentsHalfbandIirStage* stages, int numStages)
+{
+	for (int s = 0; s < numStages; ++s)
+	{
+		flushDenormalBlock(stages[s].upX, HALFBAND_IIR_MAX_COEFFS);
+		flushDenormalBlock(stages[s].upY, HALFBAND_IIR_MAX_COEFFS);
+		flushDenormalBlock(stages[s].downX, HALFBAND_IIR_MAX_COEFFS);
+		flushDenormalBlock(stages[s].downY, HALFBAND_IIR_MAX_COEFFS);
+	}
+}
+
+// ============================================================================
+// FILTER CORE
+// ============================================================================
+
+/**
+ * The SVF's state and coefficients, copied out of the DTC for the length of
+ * a kernel's loop: stores to the sample buffer could otherwise alias them,
+ * and every substep would reload them from memory
+ */
+struct _tangentsSvfCore
+{
+	float lp;
+	float bp;
+	float hp;
+	float g;
+	float k;
+	float gInv;
+};
+
+/**
+ * Copy the SVF out of the DTC before a kernel's loop
+ */
+inline void svfLoad(_tangentsSvfCore* s, const _tangentsAlgorithm_DTC* dtc)
+{
+	s->lp = dtc->lp;
+	s->bp = dtc->bp;
+	s->hp = dtc->hp;
+	s->g = dtc->g;
+	s->k = dtc->k;
+	s->gInv = dtc->gInv;
+}
+
+/**
+ * Write the SVF state back after a kernel's loop
+ */
+inline void svfStore(_tangentsAlgorithm_DTC* dtc, const _tangentsSvfCore* s)
+{
+	dtc->lp = s->lp;
+	dtc->bp = s->bp;
+	dtc->hp = s->hp;
+}
+
+/**
+ * One SVF substep at the oversampled rate on the DTC or an _tangentsSvfCore;
+ * returns the output of `mode`, fixed at compile time so that the step
+ * kernels carry no mode switch
+ */
+template <FilterMode mode, class Svf>
+TANGENTS_INLINE float svfSubstep(Svf* dtc, float u)
+{
+	// Trapezoidal (TPT) State Variable Filter
+	// This topology is stable and doesn't blow up at high resonance
+	//
+	// hp = (input - k*bp - lp) / (1 + k*g + g*g)
+	// bp_new = g*hp + bp
+	// lp_new = g*bp_new + lp
+
+	float hp = (u - dtc->k * dtc->bp - dtc->lp) * dtc->gInv;
+	float bp = dtc->g * hp + dtc->bp;
+	float lp = dtc->g * bp + dtc->lp;
+
+	// Soft clamp states for safety (shouldn't be needed with proper TPT)
+	GUARD_COUNT_CLAMP(clampBp, bp, 5.0f);
+	GUARD_COUNT_CLAMP(clampLp, lp, 5.0f);
+	bp = softClamp(bp, 5.0f);
+	lp = softClamp(lp, 5.0f);
+
+	// Update state
+	GUARD_COUNT_SANITIZE(sanitizeBp, bp);
+	GUARD_COUNT_SANITIZE(sanitizeLp, lp);
+	GUARD_COUNT_SANITIZE(sanitizeHp, hp);
+	dtc->bp = sanitize(bp);
+	dtc->lp = sanitize(lp);
+	dtc->hp = sanitize(hp);
+
+	// Output based on mode
+	switch (mode)
+	{
+		case kFilterModeBandpass:
+			return bp;
+		case kFilterModeHighpass:
+			return hp;
+		case kFilterModeAllpass:
+			return lp - hp;
+		case kFilterModeLowpass:
+		default:
+			return lp;
+	}
+}
+
+/**
+ * One SVF substep with the mode chosen at run time
+ */
+template <class Svf>
+TANGENTS_INLINE float svfSubstep(Svf* dtc, float u, FilterMode mode)
+{
+	switch (mode)
+	{
+		case kFilterModeBandpass:
+			return svfSubstep<kFilterModeBandpass>(dtc, u);
+		case kFilterModeHighpass:
+			return svfSubstep<kFilterModeHighpass>(dtc, u);
+		case kFilterModeAllpass:
+			return svfSubstep<kFilterModeAllpass>(dtc, u);
+		case kFilterModeLowpass:
+		default:
+			return svfSubstep<kFilterModeLowpass>(dtc, u);
+	}
+}
+
+// ============================================================================
+// BLOCK STAGES
+// ============================================================================
+
+/*
+step() runs each chunk of a block through these one at a time, each a flat
+loop over a contiguous buffer, so every stage can be timed on its own (see
+tools/bench.cpp) and none carries the others' branches in its loop.
+*/
+
+/**
+ * AGR and drive into x; returns the peak absolute level
+ */
+inline float inputStage(_tangentsAlgorithm_DTC* dtc, const float* in, float* x, int n)
+{
+	int agr = (int)dtc->agrSmooth;
+	float drive = dtc->driveSmooth;
+	uint32_t randState = dtc->randState;
+	float peak = 0.0f;
+
+	for (int i = 0; i < n; ++i)
+	{
+		float input = in[i] * processAGR(agr, randState) * drive;
+
+		// Recursive resampler state (IIR halfbands, multirate) would never
+		// recover from a non-finite sample; subnormal input would be carried
+		// at a fraction of the speed through every oversampled stage
+		GUARD_COUNT_SANITIZE(sanitizeInput, input);
+		input = flushDenormal(sanitize(input));
+		x[i] = input;
+
+		float absIn = fabsf(input);
+		if (absIn > peak) peak = absIn;
+	}
+
+	dtc->randState = randState;
+	return peak;
+}
+
+/**
+ * First-order ADAA of saturator f (antiderivative F) over x * gain, in place:
+ * (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1]), or f at the midpoint for steps
+ * below ADAA_EPSILON. Arguments are flushed to zero below DENORMAL_FLOOR:
+ * F squares them, and the state carries x and F(x) into the next block.
+ */
+template <float (*f)(float), float (*F)(float)>
+inline void adaaBlock(float* x, int n, float gain, _tangentsAdaaState* st)
+{
+	float x1 = st->x1;
+	float F1 = st->F1;
+
+	for (int i = 0; i < n; ++i)
+	{
+		float xi = flushDenormal(x[i] * gain);
+		float Fi = F(xi);
+		float d = xi - x1;
+		x[i] = (fabsf(d) > ADAA_EPSILON) ? (Fi - F1) / d : f(0.5f * (xi + x1));
+		x1 = xi;
+		F1 = Fi;
+	}
+
+	st->x1 = x1;
+	st->F1 = F1;
+}
+
+/**
+ * Plain saturation of x * gain in place; the state argument is for the ADAA
+ * kernels' signature
+ */
+template <float (*f)(float)>
+inline void saturatePlainBlock(float* x, int n, float gain, _tangentsAdaaState*)
+{
+	for (int i = 0; i < n; ++i)
+		x[i] = f(x[i] * gain);
+}
+
+/**
+ * The model's resonance-dependent gain into the input saturator
+ */
+inline float inputSaturationGain(int model, float resAmt)
+{
+	switch (model)
+	{
+		case 0:  return 1.0f + resAmt;
+		case 1:
+		case MODEL_MS_TABLE:
+			return 1.0f + resAmt * 0.5f;
+		case 2:  return 1.0f + resAmt * 2.0f;
+		default: return 1.0f;
+	}
+}
+
+/**
+ * One SVF substep per sample in place (halfband and interpolating paths, x
+ * at the oversampled rate), for the template's mode; the argument is for the
+ * run-time mode kernel's signature
+ */
+template <FilterMode mode>
+inline void svfBlock(_tangentsAlgorithm_DTC* dtc, float* x, int n, FilterMode)
+{
+	_tangentsSvfCore s;
+	svfLoad(&s, dtc);
+	for (int i = 0; i < n; ++i)
+		x[i] = svfSubstep<mode>(&s, x[i]);
+	svfStore(dtc, &s);
+}
+
+/**
+ * svfBlock with the mode chosen per substep
+ */
+inline void svfBlock(_tangentsAlgorithm_DTC* dtc, float* x, int n, FilterMode mode)
+{
+	_tangentsSvfCore s;
+	svfLoad(&s, dtc);
+	for (int i = 0; i < n; ++i)
+		x[i] = svfSubstep(&s, x[i], mode);
+	svfStore(dtc, &s);
+}
+
+/**
+ * Closed-form update of the hold path's substeps for input u, if no substep
+ * can reach the clamps (NaN falls through to the substep loop, which
+ * sanitizes it); returns false to leave it to the substeps
+ */
+TANGENTS_INLINE bool svfTransitionStep(_tangentsSvfCore* s, const _tangentsSvfTransition* t, float u, float* y)
+{
+	if (!(t->stateGain * maxSelect(fabsf(s->bp), fabsf(s->lp)) + t->inputGain * fabsf(u) < 5.0f))
+		return false;
+
+	float bp0 = s->bp;
+	float lp0 = s->lp;
+	*y = t->c0 * bp0 + t->c1 * lp0 + t->d * u;
+	s->hp = t->h0 * bp0 + t->h1 * lp0 + t->hu * u;
+	s->bp = t->a00 * bp0 + t->a01 * lp0 + t->b0 * u;
+	s->lp = t->a10 * bp0 + t->a11 * lp0 + t->b1 * u;
+	return true;
+}
+
+/**
+ * Hold path in place above 1x: each saturated input u held for `oversample`
+ * substeps and the outputs averaged, through the transition's closed form
+ * whenever it applies; for the template's mode (the argument is for the
+ * run-time mode kernel's signature)
+ */
+template <FilterMode mode>
+inline void svfHoldBlock(_tangentsAlgorithm_DTC* dtc, const _tangentsSvfTransition* t, float* x, int n, int oversample, FilterMode)
+{
+	_tangentsSvfCore s;
+	svfLoad(&s, dtc);
+	for (int i = 0; i < n; ++i)
+	{
+		float u = x[i];
+		if (svfTransitionStep(&s, t, u, &x[i]))
+			continue;
+
+		float output = 0.0f;
+		for (int os = 0; os < oversample; ++os)
+			output += svfSubstep<mode>(&s, u);
+		x[i] = output / (float)oversample;
+	}
+	svfStore(dtc, &s);
+}
+
+/**
+ * svfHoldBlock with the mode chosen per substep
+ */
+inline void svfHoldBlock(_tangentsAlgorithm_DTC* dtc, const _tangentsSvfTransition* t, float* x, int n, int oversample, FilterMode mode)
+{
+	_tangentsSvfCore s;
+	svfLoad(&s, dtc);
+	for (int i = 0; i < n; ++i)
+	{
+		float u = x[i];
+		if (svfTransitionStep(&s, t, u, &x[i]))
+			continue;
+
+		float output = 0.0f;
+		for (int os = 0; os < oversample; ++os)
+			output += svfSubstep(&s, u, mode);
+		x[i] = output / (float)oversample;
+	}
+	svfStore(dtc, &s);
+}
+
+/*
+The per-sample loops of the block stages are compiled once per setting they
+depend on: the saturators per model and Antialias, the SVF per mode. step()
+looks the setting's kernels up once per block, and the path blocks call
+through them, so no loop switches on the model or mode. The per-sample
+helpers they are built from (saturators, SVF substep, transition step,
+sanitize) are TANGENTS_INLINE, so each loop is a single body without calls.
+At 1x the hold path runs the plain SVF kernel: with one substep there is
+nothing to hold.
+
+Built with TANGENTS_HOT_KERNELS_ONLY (make KERNELS=hot), only Lowpass, the
+default mode, has its own SVF kernels; the other modes share kernels that
+switch per substep, for a smaller plugin.
+*/
+
+typedef void (*_tangentsSaturateKernel)(float* x, int n, float gain, _tangentsAdaaState* adaa);
+typedef void (*_tangentsSvfKernel)(_tangentsAlgorithm_DTC* dtc, float* x, int n, FilterMode mode);
+typedef void (*_tangentsSvfHoldKernel)(_tangentsAlgorithm_DTC* dtc, const _tangentsSvfTransition* t, float* x, int n, int oversample, FilterMode mode);
+
+/**
+ * The kernels of one Model x Mode x Antialias setting (selectKernels)
+ */
+struct _tangentsKernels
+{
+	_tangentsSaturateKernel saturate;
+	_tangentsSvfKernel svf;
+	_tangentsSvfHoldKernel svfHold;
+	int model;              // for the input saturation gain
+	FilterMode mode;        // for the kernels that switch per substep
+};
+
+// Saturators by model (MODEL_MS_TABLE last), plain and with ADAA
+static const _tangentsSaturateKernel saturateKernels[MODEL_MS_TABLE + 1][2] = {
+	{ saturatePlainBlock<fastTanh>, adaaBlock<fastTanh, fastTanhAntiderivative> },
+	{ saturatePlainBlock<diodeClip>, adaaBlock<diodeClip, diodeClipAntiderivative> },
+	{ saturatePlainBlock<aggressiveSat>, adaaBlock<aggressiveSat, aggressiveSatAntiderivative> },
+	{ saturatePlainBlock<diodeClipTable>, adaaBlock<diodeClipTable, diodeClipTableAntiderivative> },
+};
+
+// SVF and hold path by mode
+#ifdef TANGENTS_HOT_KERNELS_ONLY
+static const _tangentsSvfKernel svfKernels[kNumFilterModes] = {
+	svfBlock<kFilterModeLowpass>, svfBlock, svfBlock, svfBlock,
+};
+static const _tangentsSvfHoldKernel svfHoldKernels[kNumFilterModes] = {
+	svfHoldBlock<kFilterModeLowpass>, svfHoldBlock, svfHoldBlock, svfHoldBlock,
+};
+#else
+static const _tangentsSvfKernel svfKernels[kNumFilterModes] = {
+	svfBlock<kFilterModeLowpass>,
+	svfBlock<kFilterModeBandpass>,
+	svfBlock<kFilterModeHighpass>,
+	svfBlock<kFilterModeAllpass>,
+};
+static const _tangentsSvfHoldKernel svfHoldKernels[kNumFilterModes] = {
+	svfHoldBlock<kFilterModeLowpass>,
+	svfHoldBlock<kFilterModeBandpass>,
+	svfHoldBlock<kFilterModeHighpass>,
+	svfHoldBlock<kFilterModeAllpass>,
+};
+#endif
+
+/**
+ * Look up the kernels of a model (including MODEL_MS_TABLE), mode and
+ * Antialias setting
+ */
+inline void selectKernels(_tangentsKernels* k, int model, FilterMode mode, bool adaa)
+{
+	k->saturate = saturateKernels[model][adaa ? 1 : 0];
+	k->svf = svfKernels[mode];
+	k->svfHold = svfHoldKernels[mode];
+	k->model = model;
+	k->mode = mode;
+}
+
+/**
+ * Model input saturation in place, with the model's resonance-dependent
+ * pre-gain
+ */
+inline void saturateInputBlock(const _tangentsKernels* k, float* x, int n, float resAmt, _tangentsAdaaState* adaa)
+{
+	k->saturate(x, n, inputSaturationGain(k->model, resAmt), adaa);
+}
+
+/**
+ * Sanitize and apply the model output saturation in place
+ */
+inline void saturateOutputBlock(const _tangentsKernels* k, float* x, int n, _tangentsAdaaState* adaa)
+{
+	for (int i = 0; i < n; ++i)
+	{
+		GUARD_COUNT_SANITIZE(sanitizeOutput, x[i]);
+		x[i] = sanitize(x[i]);
+	}
+	k->saturate(x, n, 1.0f, adaa);
+}
+
+/**
+ * Hold path SVF in place: the held kernel above 1x (t is then required),
+ * the plain one at 1x
+ */
+inline void svfHeldBlock(const _tangentsKernels* k, _tangentsAlgorithm_DTC* dtc, const _tangentsSvfTransition* t, float* x, int n, int oversample)
+{
+	if (oversample > 1)
+		k->svfHold(dtc, t, x, n, oversample, k->mode);
+	else
+		k->svf(dtc, x, n, k->mode);
+}
+
+/**
+ * Whole hold path in place: input saturation, held SVF substeps, output
+ * saturation
+ */
+inline void holdPathBlock(const _tangentsKernels* k, _tangentsAlgorithm_DTC* dtc, const _tangentsSvfTransition* t, float* x, int n, int oversample,
+                          float resAmt, _tangentsAdaaState* adaaIn, _tangentsAdaaState* adaaOut)
+{
+	saturateInputBlock(k, x, n, resAmt, adaaIn);
+	svfHeldBlock(k, dtc, t, x, n, oversample);
+	saturateOutputBlock(k, x, n, adaaOut);
+}
+
+/**
+ * Fill the `oversample` substeps of each sample with the input trajectory
+ * rather than a held value: linearly from the previous input to this one,
+ * or (cubic) through a 4-point Hermite spline from the input before to the
+ * previous one, one sample later. The last substep lands on the sample.
+ */
+inline void interpolateBlock(float* hist, bool cubic, const float* x, int n, int oversample, float* xs)
+{
+	float p0 = hist[0];
+	float p1 = hist[1];
+	float p2 = hist[2];
+	float dt = 1.0f / (float)oversample;
+
+	if (cubic)
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			float p3 = x[i];
+			float c1 = 0.5f * (p2 - p0);
+			float c2 = p0 - 2.5f * p1 + 2.0f * p2 - 0.5f * p3;
+			float c3 = 0.5f * (p3 - p0) + 1.5f * (p1 - p2);
+			for (int j = 0; j < oversample; ++j)
+			{
+				float t = (float)(j + 1) * dt;
+				*xs++ = ((c3 * t + c2) * t + c1) * t + p1;
+			}
+			p0 = p1;
+			p1 = p2;
+			p2 = p3;
+		}
+	}
+	else
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			float p3 = x[i];
+			float d = (p3 - p2) * dt;
+			for (int j = 0; j < oversample; ++j)
+				*xs++ = p2 + (float)(j + 1) * d;
+			p0 = p1;
+			p1 = p2;
+			p2 = p3;
+		}
+	}
+
+	hist[0] = p0;
+	hist[1] = p1;
+	hist[2] = p2;
+}
+
+/**
+ * Delay of the interpolated input relative to the held one at DC, in
+ * base-rate samples: the mean lag of the substep times, plus one for cubic
+ */
+inline float interpolationLatency(bool cubic, int numStages)
+{
+	return (cubic ? 1.0f : 0.0f) + 0.5f - 0.5f / (float)(1 << numStages);
+}
+
+/**
+ * Mean of each group of `oversample` substeps into one output sample
+ */
+inline void averageBlock(const float* xs, int n, int oversample, float* x)
+{
+	float scale = 1.0f / (float)oversample;
+	for (int i = 0; i < n; ++i)
+	{
+		float sum = 0.0f;
+		for (int j = 0; j < oversample; ++j)
+			sum += *xs++;
+		x[i] = sum * scale;
+	}
+}
+
+/**
+ * Whole interpolating path in place: interpolate into xs, input saturation
+ * and the filter on every substep, average back, output saturation
+ */
+inline void interpolatedPathBlock(const _tangentsKernels* k, _tangentsAlgorithm_DTC* dtc, float* hist, bool cubic, float* x, int n, int oversample, float* xs,
+                                  float resAmt, _tangentsAdaaState* adaaIn, _tangentsAdaaState* adaaOut)
+{
+	int ns = n * oversample;
+	interpolateBlock(hist, cubic, x, n, oversample, xs);
+	saturateInputBlock(k, xs, ns, resAmt, adaaIn);
+	k->svf(dtc, xs, ns, k->mode);
+	averageBlock(xs, n, oversample, x);
+	saturateOutputBlock(k, x, n, adaaOut);
+}
+
+/**
+ * Upsample n base-rate samples into n << numStages oversampled samples
+ */
+template <class Stage>
+inline void halfbandUpsampleBlock(Stage* stages, int numStages, const float* x, int n, float* xs)
+{
+	const int factor = 1 << numStages;
+	for (int i = 0; i < n; ++i)
+		halfbandUpsample(stages, numStages, x[i], xs + i * factor);
+}
+
+/**
+ * Decimate n << numStages oversampled samples (overwritten) into n
+ */
+template <class Stage>
+inline void halfbandDownsampleBlock(Stage* stages, int numStages, float* xs, int n, float* x)
+{
+	const int factor = 1 << numStages;
+	for (int i = 0; i < n; ++i)
+		x[i] = halfbandDownsample(stages, numStages, xs + i * factor);
+}
+
+/**
+ * Whole halfband path in place: interpolate into xs, then run both
+ * saturators and the filter on every oversampled sample so their harmonics
+ * are removed by the decimator rather than folded back; the stages' state
+ * is flushed of near-zero values afterwards
+ */
+template <class Stage>
+inline void halfbandPathBlock(const _tangentsKernels* k, _tangentsAlgorithm_DTC* dtc, Stage* stages, int numStages, float* x, int n, float* xs,
+                              float resAmt, _tangentsAdaaState* adaaIn, _tangentsAdaaState* adaaOut)
+{
+	int ns = n << numStages;
+	halfbandUpsampleBlock(stages, numStages, x, n, xs);
+	saturateInputBlock(k, xs, ns, resAmt, adaaIn);
+	k->svf(dtc, xs, ns, k->mode);
+	saturateOutputBlock(k, xs, ns, adaaOut);
+	halfbandDownsampleBlock(stages, numStages, xs, n, x);
+	halfbandFlush(stages, numStages);
+}
+
+/**
+ * Write or mix y into the output bus; returns the peak absolute level
+ */
+inline float outputStage(float* out, const float* y, int n, bool replace)
+{
+	float peak = 0.0f;
+	for (int i = 0; i < n; ++i)
+	{
+		float absOut = fabsf(y[i]);
+		if (absOut > peak) peak = absOut;
+	}
+
+	if (replace)
+		memcpy(out, y, n * sizeof(float));
+	else
+		for (int i = 0; i < n; ++i)
+			out[i] += y[i];
+	return peak;
+}
+
+// ============================================================================
+// AUTO OVERSAMPLING
+// ============================================================================
+
+/**
+ * Filter state that depends on the oversampling factor, so that a second
+ * factor can render the same chunk from its own state (the halfband history
+ * is kept separately, in fadeHalfband)
+ */
+struct _tangentsFadeState
+{
+	float lp;
+	float bp;
+	float hp;
+	float g;
+	float gInv;
+	_tangentsAdaaState adaaIn;
+	_tangentsAdaaState adaaOut;
+};
+
+/**
+ * Exchange the DTC's factor-dependent filter state with *s
+ */
+inline void swapFadeState(_tangentsAlgorithm_DTC* dtc, _tangentsFadeState* s)
+{
+	_tangentsFadeState t = *s;
+	s->lp = dtc->lp;
+	s->bp = dtc->bp;
+	s->hp = dtc->hp;
+	s->g = dtc->g;
+	s->gInv = dtc->gInv;
+	s->adaaIn = dtc->adaaIn;
+	s->adaaOut = dtc->adaaOut;
+	dtc->lp = t.lp;
+	dtc->bp = t.bp;
+	dtc->hp = t.hp;
+	dtc->g = t.g;
+	dtc->gInv = t.gInv;
+	dtc->adaaIn = t.adaaIn;
+	dtc->adaaOut = t.adaaOut;
+}
+
+/**
+ * Oversampling octaves wanted for a peak level into the saturators: none
+ * while they stay near-linear (3rd harmonic below about -40 dB), one more
+ * per step of harder drive, and one or two fewer for a low-pass or
+ * band-pass whose cutoff (as a fraction of the sample rate) keeps the
+ * harmonics out of the top octaves
+ */
+inline int autoOversampleDemand(float level, float cutoffRatio, FilterMode mode)
+{
+	int stages = (level < 0.1f) ? 0 : (level < 0.4f) ? 1 : (level < 1.2f) ? 2 : (level < 3.0f) ? 3 : 4;
+
+	if (stages > 1 && (mode == kFilterModeLowpass || mode == kFilterModeBandpass))
+	{
+		if (cutoffRatio < 1.0f / 64.0f)
+			stages -= 2;
+		else if (cutoffRatio < 1.0f / 16.0f)
+			stages -= 1;
+		if (stages < 1)
+			stages = 1;
+	}
+	return stages;
+}
+
+/**
+ * Auto's octaves for this block, from the previous block's peaks: up as
+ * soon as the demand rises, down one octave after
+ * AUTO_OVERSAMPLE_HOLD_BLOCKS blocks of lower demand, never below minStages
+ * or above maxStages
+ */
+inline int updateAutoOversample(_tangentsAlgorithm_DTC* dtc, int model, FilterMode mode, float sampleRateRecip, int minStages, int maxStages)
+{
+	float level = fmaxf(dtc->autoPeakIn * inputSaturationGain(model, dtc->resonanceSmooth), dtc->autoPeakOut);
+	int want = autoOversampleDemand(level, dtc->cutoffSmooth * sampleRateRecip, mode);
+	if (want < minStages)
+		want = minStages;
+	if (want > maxStages)
+		want = maxStages;
+
+	if (want >= dtc->autoStages)
+	{
+		dtc->autoStages = want;
+		dtc->autoHoldBlocks = 0;
+	}
+	else if (++dtc->autoHoldBlocks >= AUTO_OVERSAMPLE_HOLD_BLOCKS)
+	{
+		--dtc->autoStages;
+		dtc->autoHoldBlocks = 0;
+	}
+	return dtc->autoStages;
+}
+
+// ============================================================================
+// MULTIRATE
+// ============================================================================
+
+/*
+A low-pass far below Nyquist has next to nothing to pass in the top octaves,
+so the whole saturated path (with its own oversampling on top) can run on a
+decimated copy of the input and be interpolated back. Every octave uses the
+steepest low-latency halfband (stage 0's design), so at 1/4 rate the path
+still passes up to 4.8 kHz (at 48 kHz) and what folds back into that band
+stays below -80 dB.
+*/
+
+/**
+ * Decimation octaves for the cutoff (as a fraction of the sample rate): one
+ * below 1/64, two below 1/128, low-pass only. A deeper setting is entered
+ * 20% below its threshold and left as soon as the cutoff rises above it.
+ */
+inline int multirateDemand(int current, float cutoffRatio, FilterMode mode)
+{
+	if (mode != kFilterModeLowpass)
+		return 0;
+	int enter = (cutoffRatio < 0.8f / 128.0f) ? 2 : (cutoffRatio < 0.8f / 64.0f) ? 1 : 0;
+	int leave = (cutoffRatio < 1.0f / 128.0f) ? 2 : (cutoffRatio < 1.0f / 64.0f) ? 1 : 0;
+	if (enter > current)
+		return enter;
+	if (leave < current)
+		return leave;
+	return current;
+}
+
+/**
+ * Decimate x in place by 1 << depth; x[0 .. n >> depth) holds the result
+ */
+inline void multirateDownBlock(_tangentsHalfbandIirStage* levels, int depth, float* x, int n)
+{
+	for (int l = 0; l < depth; ++l, n /= 2)
+	{
+		for (int i = 0; i < n / 2; ++i)
+			x[i] = halfbandDecimate(&levels[l], halfbandIirDesigns[0], x[2 * i], x[2 * i + 1]);
+	}
+}
+
+/**
+ * Interpolate x[0 .. n >> depth) in place back up to n samples
+ */
+inline void multirateUpBlock(_tangentsHalfbandIirStage* levels, int depth, float* x, int n)
+{
+	for (int l = depth - 1; l >= 0; --l)
+	{
+		// From the upper half, so every sample is read before its slot is
+		// written and the recursion still runs forward in time
+		int m = n >> (l + 1);
+		memmove(x + m, x, m * sizeof(float));
+		for (int i = 0; i < m; ++i)
+			halfbandInterpolate(&levels[l], halfbandIirDesigns[0], x[m + i], x + 2 * i);
+	}
+}
+
+/**
+ * Settle octaves from..to-1 at the latest levels into and out of the
+ * decimated path, so engaging them does not start from silence
+ */
+inline void multiratePrime(_tangentsHalfbandIirStage* levels, int from, int to, float in, float out)
+{
+	for (int l = from; l < to; ++l)
+	{
+		for (int i = 0; i < HALFBAND_IIR_MAX_COEFFS; ++i)
+		{
+			levels[l].downX[i] = levels[l].downY[i] = in;
+			levels[l].upX[i] = levels[l].upY[i] = out;
+		}
+	}
+}
+
+/**
+ * Group delay of decimation and interpolation at DC, in base-rate samples
+ */
+inline float multirateLatency(int depth)
+{
+	return halfbandIirDelay(halfbandIirDesigns[0]) * (float)((1 << depth) - 1);
+}
+
+// ============================================================================
+// CYCLE STATISTICS
+// ============================================================================
+
+/**
+ * Clear all cycle statistics and start a new window
+ */
+inline void resetCycleStats(_tangentsCycleStats* stats)
+{
+	memset(stats, 0, sizeof(_tangentsCycleStats));
+	stats->windowBlockMin = 0xFFFFFFFF;
+	stats->windowSampleMin = 0xFFFFFFFF;
+}
+
+/**
+ * Account one block of numFrames that took `ticks` to process
+ */
+inline void updateCycleStats(_tangentsCycleStats* stats, uint32_t ticks, int numFrames)
+{
+	uint32_t perSample = ticks / (uint32_t)numFrames;
+
+	if (ticks < stats->windowBlockMin) stats->windowBlockMin = ticks;
+	if (ticks > stats->windowBlockMax) stats->windowBlockMax = ticks;
+	if (perSample < stats->windowSampleMin) stats->windowSampleMin = perSample;
+	if (perSample > stats->windowSampleMax) stats->windowSampleMax = perSample;
+	if (perSample > stats->samplePeak) stats->samplePeak = perSample;
+
+	stats->windowTicks += ticks;
+	stats->windowFrames += numFrames;
+
+	if (++stats->windowBlocks < CYCLE_STATS_WINDOW)
+		return;
+
+	// Publish the window and start the next one
+	stats->blockMin = stats->windowBlockMin;
+	stats->blockMean = stats->windowTicks / stats->windowBlocks;
+	stats->blockMax = stats->windowBlockMax;
+	stats->sampleMin = stats->windowSampleMin;
+	stats->sampleMean = stats->windowTicks / stats->windowFrames;
+	stats->sampleMax = stats->windowSampleMax;
+
+	stats->windowBlocks = 0;
+	stats->windowFrames = 0;
+	stats->windowTicks = 0;
+	stats->windowBlockMin = 0xFFFFFFFF;
+	stats->windowBlockMax = 0;
+	stats->windowSampleMin = 0xFFFFFFFF;
+	stats->windowSampleMax = 0;
+}
+
+/**
+ * Fraction of the real-time budget used, in percent, for a per-sample cost
+ */
+inline float cycleLoadPercent(uint32_t ticksPerSample)
+{
+	return (float)ticksPerSample * (float)NT_globals.sampleRate / (float)CYCLE_COUNTER_HZ * 100.0f;
+}
+
+// ============================================================================
+// CPU GOVERNOR
+// ============================================================================
+
+/**
+ * Judge a block that ran `stages` octaves at `load` percent of its
+ * deadline: one more octave is shed as soon as a block goes over the budget
+ * (down to minStages), and one comes back after GOVERNOR_RESTORE_BLOCKS
+ * blocks in a row under GOVERNOR_HEADROOM of it
+ */
+inline void updateGovernor(_tangentsAlgorithm_DTC* dtc, float load, float budget, int stages, int minStages)
+{
+	if (load > budget)
+	{
+		if (stages > minStages)
+			++dtc->governorShed;
+		dtc->governorHoldBlocks = 0;
+	}
+	else if (dtc->governorShed > 0 && load < budget * GOVERNOR_HEADROOM)
+	{
+		if (++dtc->governorHoldBlocks >= GOVERNOR_RESTORE_BLOCKS)
+		{
+			--dtc->governorShed;
+			dtc->governorHoldBlocks = 0;
+		}
+	}
+	else
+		dtc->governorHoldBlocks = 0;
+}
+
+// ============================================================================
+// FACTORY FUNCTIONS
+// ============================================================================
+
+void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* specifications)
+{
+	_tangentsMemoryLayout layout;
+	calculateMemoryLayout(&layout, specifications);
+
+	req.numParameters = ARRAY_SIZE(parameters);
+	req.sram = layout.sram;
+	// Block pipeline scratch for a full block at the highest oversampling
+	req.dram = sizeof(float) * NT_globals.maxFramesPerStep * layout.scratchFloatsPerFrame;
+	req.dtc = layout.dtc;
+	req.itc = 0;
+}
+
+_NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs,
+                        const _NT_algorithmRequirements& req,
                         const int32_t* specifications)
 {
 	_tangentsAlgorithm* alg = new (ptrs.sram) _tangentsAlgorithm(
@@ -386,12 +2329,35 @@ _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs,
 	alg->parameters = parameters;
 	alg->parameterPages = &parameterPages;
 
-	// Initialize DTC memory
-	memset(alg->dtc, 0, sizeof(_tangentsAlgorithm_DTC));
+	_tangentsMemoryLayout layout;
+	calculateMemoryLayout(&layout, specifications);
+	alg->maxStages = layout.maxStages;
+	alg->halfbands = layout.halfbands;
+	alg->maxMultirateDepth = layout.maxMultirateDepth;
+
+	// Initialize DTC memory, halfband and multirate stages included
+	memset(alg->dtc, 0, layout.dtc);
+	alg->dtc->halfband = layout.dtcHalfband ? (_tangentsHalfbandStage*)(ptrs.dtc + layout.dtcHalfband) : NULL;
+	alg->dtc->halfbandIir = layout.dtcHalfbandIir ? (_tangentsHalfbandIirStage*)(ptrs.dtc + layout.dtcHalfbandIir) : NULL;
+	alg->dtc->multirate = layout.dtcMultirate ? (_tangentsHalfbandIirStage*)(ptrs.dtc + layout.dtcMultirate) : NULL;
+	alg->fadeHalfband = layout.sramHalfband ? (_tangentsHalfbandStage*)(ptrs.sram + layout.sramHalfband) : NULL;
+	alg->fadeHalfbandIir = layout.sramHalfbandIir ? (_tangentsHalfbandIirStage*)(ptrs.sram + layout.sramHalfbandIir) : NULL;
+	alg->fadeMultirate = layout.sramMultirate ? (_tangentsHalfbandIirStage*)(ptrs.sram + layout.sramMultirate) : NULL;
+
+	// Split the DRAM scratch into the base-rate and oversampled buffers
+	alg->scratchFrames = req.dram / (sizeof(float) * layout.scratchFloatsPerFrame);
+	alg->scratchFrames &= ~((1 << MULTIRATE_MAX_DEPTH) - 1);    // chunks decimate evenly
+	alg->scratch = (float*)ptrs.dram;
+	alg->scratchFade = alg->scratch + alg->scratchFrames;
+	alg->scratchOversampled = alg->scratchFade + alg->scratchFrames;
 
 	// Initialize cached values
 	alg->sampleRateRecip = 1.0f / NT_globals.sampleRate;
 
+	// Start the cycle counter and clear timing statistics
+	cycleCounterInit();
+	resetCycleStats(&alg->cycles);
+
 	// Initialize random state for AGR (use a non-zero seed)
 	alg->dtc->randState = 0x12345678;
 
@@ -412,11 +2378,31 @@ _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs,
 
 void parameterChanged(_NT_algorithm* self, int p)
 {
-	(void)self;  // Unused - we use smoothing in step() instead
-	(void)p;
+	_tangentsAlgorithm* pThis = (_tangentsAlgorithm*)self;
 
 	// Filter parameters trigger coefficient recalculation on next step()
 	// We use smoothing in the audio loop for zipper-free changes
+
+	// Turning diagnostics on starts a fresh measurement
+	if (p == kParamDiagnostics)
+		resetCycleStats(&pThis->cycles);
+
+	// The resampler stages in use change; don't replay stale history
+	if (p == kParamOversample || p == kParamResampler)
+	{
+		if (pThis->dtc->halfband)
+			memset(pThis->dtc->halfband, 0, pThis->maxStages * sizeof(_tangentsHalfbandStage));
+		if (pThis->dtc->halfbandIir)
+			memset(pThis->dtc->halfbandIir, 0, pThis->maxStages * sizeof(_tangentsHalfbandIirStage));
+		memset(pThis->dtc->interp, 0, sizeof(pThis->dtc->interp));
+	}
+
+	// ADAA memory belongs to one model's antiderivative and one rate
+	if (p == kParamModel || p == kParamSaturator || p == kParamAntialias || p == kParamOversample || p == kParamResampler)
+	{
+		memset(&pThis->dtc->adaaIn, 0, sizeof(pThis->dtc->adaaIn));
+		memset(&pThis->dtc->adaaOut, 0, sizeof(pThis->dtc->adaaOut));
+	}
 }
 
 void step(_NT_algorithm* self, float* busFrames, int numFramesBy4)
@@ -424,6 +2410,9 @@ void step(_NT_algorithm* self, float* busFrames, int numFramesBy4)
 	_tangentsAlgorithm* pThis = (_tangentsAlgorithm*)self;
 	_tangentsAlgorithm_DTC* dtc = pThis->dtc;
 
+	uint32_t startTicks = cycleCounterRead();
+	uint32_t floatMode = floatModeFlushToZero();
+
 	int numFrames = numFramesBy4 * 4;
 
 	// Get audio busses
@@ -446,16 +2435,13 @@ void step(_NT_algorithm* self, float* busFrames, int numFramesBy4)
 	float baseResonance = pThis->v[kParamResonance] / 1000.0f;   // 0.0 - 1.0 (raw 0-1000)
 	FilterMode mode = (FilterMode)pThis->v[kParamMode];
 	int model = pThis->v[kParamModel];  // 0=YU, 1=MS, 2=XX
+	if (model == 1 && pThis->v[kParamSaturator])
+		model = MODEL_MS_TABLE;
 	float cvCutoffAmtTarget = pThis->v[kParamCvCutoffAmt] / 1000.0f;     // -1.0 to 1.0 (raw -1000 to 1000)
 	float cvResAmtTarget = pThis->v[kParamCvResonanceAmt] / 1000.0f;     // -1.0 to 1.0 (raw -1000 to 1000)
 	float agrTarget = pThis->v[kParamInputAGR] / 10.0f;          // 0.0 - 100.0 (raw 0-1000)
 	float driveTarget = 1.0f + pThis->v[kParamDrive] / 250.0f;   // 1.0 to 5.0 (raw 0-1000)
 
-	// Oversampling: 0=1x, 1=2x, 2=4x, 3=8x, 4=16x
-	int osParam = pThis->v[kParamOversample];
-	int oversample = 1 << osParam;  // 1, 2, 4, 8, or 16
-	float oversampleRate = NT_globals.sampleRate * oversample;
-
 	// Level tracking
 	float maxIn = 0.0f;
 	float maxOut = 0.0f;
@@ -476,13 +2462,15 @@ void step(_NT_algorithm* self, float* busFrames, int numFramesBy4)
 
 	if (cvCutoff)
 	{
-		float cvVal = cvCutoff[0] * dtc->cvCutoffAmtSmooth;
-		cutoff *= powf(2.0f, cvVal * 5.0f);  // 1V/oct: ±5 octaves
+		// NaN or out-of-range CV must not reach the smoothed cutoff, where it
+		// would persist across blocks
+		float cvVal = sanitize(cvCutoff[0]) * dtc->cvCutoffAmtSmooth;
+		cutoff *= exp2Table(softClamp(cvVal * 5.0f));   // 1V/oct: ±5 octaves at ±1, limited to ±10
 	}
 
 	if (cvResonance)
 	{
-		float cvVal = cvResonance[0] * dtc->cvResAmtSmooth;
+		float cvVal = sanitize(cvResonance[0]) * dtc->cvResAmtSmooth;
 		resonance += cvVal * 0.5f;
 		if (resonance < 0.0f) resonance = 0.0f;
 		if (resonance > 1.0f) resonance = 1.0f;
@@ -492,130 +2480,326 @@ void step(_NT_algorithm* self, float* busFrames, int numFramesBy4)
 	dtc->cutoffSmooth += (cutoff - dtc->cutoffSmooth) * smoothCoeff;
 	dtc->resonanceSmooth += (resonance - dtc->resonanceSmooth) * smoothCoeff;
 
+	// Oversampling: 0=1x, 1=2x, 2=4x, 3=8x, 4=16x, 5=Auto. With the halfband
+	// and interpolating resamplers Auto stays at 2x or above, where the
+	// latency only varies by a fraction of a sample (a few with the halfband
+	// FIRs) between factors.
+	int resampler = activeResampler(pThis);
+	bool halfbandResampler = resampler == kResamplerHalfband || resampler == kResamplerHalfbandIir;
+	bool iir = resampler == kResamplerHalfbandIir;
+	bool interpolatingResampler = resampler == kResamplerLinear || resampler == kResamplerCubic;
+	bool cubic = resampler == kResamplerCubic;
+	int osParam = pThis->v[kParamOversample];
+	bool autoOversample = osParam == OVERSAMPLE_AUTO;
+	int previousStages = dtc->runStages;
+	int previousRequest = dtc->autoStages;
+	int minStages = (halfbandResampler || interpolatingResampler) && pThis->maxStages > 0 ? 1 : 0;
+	if (autoOversample)
+		osParam = updateAutoOversample(dtc, model, mode, pThis->sampleRateRecip, minStages, pThis->maxStages);
+	else
+	{
+		// Above the Max oversample specification the highest allocated
+		// factor runs; Auto takes over from the fixed factor
+		osParam = activeOversampleStages(pThis);
+		dtc->autoStages = osParam;
+		dtc->autoHoldBlocks = 0;
+	}
+
+	// CPU governor: the octaves it has shed under load come off the factor,
+	// down to the floor Auto keeps
+	float budget = pThis->v[kParamCpuBudget] / 10.0f;   // % (raw 0-1000), 0=Off
+	if (budget <= 0.0f)
+	{
+		dtc->governorShed = 0;
+		dtc->governorHoldBlocks = 0;
+	}
+	int requested = osParam;
+	if (dtc->governorShed > 0 && osParam > minStages)
+	{
+		osParam -= dtc->governorShed;
+		if (osParam < minStages)
+			osParam = minStages;
+	}
+
+	// A factor changed by Auto or the governor fades; a change of the
+	// parameter itself starts over
+	int fadeStages = -1;    // factor faded out over this block
+	if (osParam != previousStages && (autoOversample || requested == previousRequest))
+		fadeStages = previousStages;
+	dtc->runStages = osParam;
+	int oversample = 1 << osParam;  // 1, 2, 4, 8, or 16
+
+	// Multirate: a low-pass far below Nyquist runs the whole path at 1/2 or
+	// 1/4 of the sample rate (oversampling on top of that), as deep as the
+	// Multirate specification allows
+	int depth = pThis->v[kParamMultirate] ? multirateDemand(dtc->multirateDepth, dtc->cutoffSmooth * pThis->sampleRateRecip, mode) : 0;
+	if (depth > pThis->maxMultirateDepth)
+		depth = pThis->maxMultirateDepth;
+	int fadeDepth = dtc->multirateDepth;    // depth faded out over this block
+	if (depth != fadeDepth)
+	{
+		if (fadeStages < 0)
+			fadeStages = osParam;
+		multiratePrime(dtc->multirate, fadeDepth, depth, dtc->multirateIn, dtc->multirateOut);
+		dtc->multirateDepth = depth;
+	}
+	float oversampleRate = NT_globals.sampleRate * (float)oversample / (float)(1 << depth);
+
+	// When Auto or the governor changes the factor or Multirate the depth,
+	// the previous setting renders the block again from its own copy of the
+	// filter state and the output crossfades
+	bool fadeHalfband = halfbandResampler && fadeStages > 0;
+	bool fadeInterpolated = interpolatingResampler && fadeStages > 0;
+	_tangentsFadeState fade;
+	_tangentsSvfTransition fadeTransition;
+	if (fadeStages >= 0)
+	{
+		calculateFilterCoeffs(dtc, dtc->cutoffSmooth, dtc->resonanceSmooth, NT_globals.sampleRate * (float)(1 << fadeStages) / (float)(1 << fadeDepth));
+		if (fadeStages > 0 && !fadeHalfband && !fadeInterpolated)
+			calculateSvfTransition(&fadeTransition, dtc, mode, 1 << fadeStages);
+		if (fadeHalfband && iir)
+		{
+			memcpy(pThis->fadeHalfbandIir, dtc->halfbandIir, pThis->maxStages * sizeof(_tangentsHalfbandIirStage));
+			halfbandExtend(dtc->halfbandIir, fadeStages, osParam);
+		}
+		else if (fadeHalfband)
+		{
+			memcpy(pThis->fadeHalfband, dtc->halfband, pThis->maxStages * sizeof(_tangentsHalfbandStage));
+			halfbandExtend(dtc->halfband, fadeStages, osParam);
+		}
+		if (pThis->maxMultirateDepth)
+			memcpy(pThis->fadeMultirate, dtc->multirate, pThis->maxMultirateDepth * sizeof(_tangentsHalfbandIirStage));
+		fade.lp = dtc->lp;
+		fade.bp = dtc->bp;
+		fade.hp = dtc->hp;
+		fade.g = dtc->g;
+		fade.gInv = dtc->gInv;
+		fade.adaaIn = dtc->adaaIn;
+		fade.adaaOut = dtc->adaaOut;
+	}
+
 	// Calculate coefficients once per block using oversampled rate
 	calculateFilterCoeffs(dtc, dtc->cutoffSmooth, dtc->resonanceSmooth, oversampleRate);
 
 	// Pre-calculate resonance amount for saturation
 	float resAmt = (2.0f - dtc->k) / 1.9f;
 
-	// Process audio
-	for (int i = 0; i < numFrames; ++i)
+	// Halfband resampling replaces hold/average, interpolation replaces the
+	// hold; at 1x there is nothing to resample
+	bool halfband = halfbandResampler && oversample > 1;
+	bool interpolated = interpolatingResampler && oversample > 1;
+
+	// Substeps composed into one map for the block; at 1x the loop is
+	// already a single substep
+	bool useTransition = oversample > 1 && !halfband && !interpolated;
+	_tangentsSvfTransition transition;
+	if (useTransition)
+		calculateSvfTransition(&transition, dtc, mode, oversample);
+
+	// Anti-derivative anti-aliasing on the saturators
+	bool adaa = pThis->v[kParamAntialias] == 1;
+	_tangentsAdaaState* adaaIn = adaa ? &dtc->adaaIn : NULL;
+	_tangentsAdaaState* adaaOut = adaa ? &dtc->adaaOut : NULL;
+
+	// The model's and mode's kernels for the whole block
+	_tangentsKernels kernels;
+	selectKernels(&kernels, model, mode, adaa);
+
+	// Process audio in chunks that fit the scratch buffers, running each
+	// stage over the whole chunk
+	for (int done = 0; done < numFrames; done += pThis->scratchFrames)
 	{
+		int n = numFrames - done;
+		if (n > pThis->scratchFrames) n = pThis->scratchFrames;
+		float* x = pThis->scratch;
 
-		// Process input through AGR (Attenu-Gain-Randomizer)
-		// Use smoothed AGR value (cast to int for zone calculation)
-		float agrGain = processAGR((int)dtc->agrSmooth, dtc->randState);
-		float input = in[i] * agrGain * dtc->driveSmooth;
-
-		// Track input level
-		float absIn = fabsf(input);
-		if (absIn > maxIn) maxIn = absIn;
+		// Input through AGR (Attenu-Gain-Randomizer) and drive
+		float peakIn = inputStage(dtc, in + done, x, n);
+		if (peakIn > maxIn) maxIn = peakIn;
+		dtc->multirateIn = x[n - 1];
 
 		// === STEINER-PARKER FILTER CORE ===
-		// Oversampled processing for stability
-		float output = 0.0f;
+		// Previous setting first (Auto or Multirate), from its own state
+		float* y = pThis->scratchFade;
+		if (fadeStages >= 0)
+		{
+			int nf = n >> fadeDepth;
+			memcpy(y, x, n * sizeof(float));
+			swapFadeState(dtc, &fade);
+			multirateDownBlock(pThis->fadeMultirate, fadeDepth, y, n);
+			if (fadeHalfband && iir)
+				halfbandPathBlock(&kernels, dtc, pThis->fadeHalfbandIir, fadeStages, y, nf, pThis->scratchOversampled, resAmt, adaaIn, adaaOut);
+			else if (fadeHalfband)
+				halfbandPathBlock(&kernels, dtc, pThis->fadeHalfband, fadeStages, y, nf, pThis->scratchOversampled, resAmt, adaaIn, adaaOut);
+			else if (fadeInterpolated)
+			{
+				// Same inputs as the new factor below, so a copy of the history
+				float hist[3];
+				memcpy(hist, dtc->interp, sizeof(hist));
+				interpolatedPathBlock(&kernels, dtc, hist, cubic, y, nf, 1 << fadeStages, pThis->scratchOversampled, resAmt, adaaIn, adaaOut);
+			}
+			else
+				holdPathBlock(&kernels, dtc, fadeStages > 0 ? &fadeTransition : NULL, y, nf, 1 << fadeStages, resAmt, adaaIn, adaaOut);
+			multirateUpBlock(pThis->fadeMultirate, fadeDepth, y, n);
+			swapFadeState(dtc, &fade);
+		}
 
-		for (int os = 0; os < oversample; ++os)
+		int nd = n >> depth;
+		multirateDownBlock(dtc->multirate, depth, x, n);
+		if (halfband && iir)
+			halfbandPathBlock(&kernels, dtc, dtc->halfbandIir, osParam, x, nd, pThis->scratchOversampled, resAmt, adaaIn, adaaOut);
+		else if (halfband)
+			halfbandPathBlock(&kernels, dtc, dtc->halfband, osParam, x, nd, pThis->scratchOversampled, resAmt, adaaIn, adaaOut);
+		else if (interpolated)
+			interpolatedPathBlock(&kernels, dtc, dtc->interp, cubic, x, nd, oversample, pThis->scratchOversampled, resAmt, adaaIn, adaaOut);
+		else
 		{
-			// Apply non-linearity based on model type
-			// The saturation tames the input to prevent filter blowup
-			float u;
+			// The saturation tames the input to prevent filter blowup, and is
+			// held across the oversampled substeps
+			holdPathBlock(&kernels, dtc, useTransition ? &transition : NULL, x, nd, oversample, resAmt, adaaIn, adaaOut);
+		}
+		dtc->multirateOut = x[nd - 1];
+		multirateUpBlock(dtc->multirate, depth, x, n);
+		halfbandFlush(dtc->multirate, depth);
 
-			switch (model)
-			{
-				case 0:  // YU - Smooth tanh saturation
-					u = fastTanh(input * (1.0f + resAmt));
-					break;
+		// Fade from the previous setting to the new one across the block
+		if (fadeStages >= 0)
+		{
+			float fadeStep = 1.0f / (float)numFrames;
+			for (int i = 0; i < n; ++i)
+				x[i] = y[i] + (x[i] - y[i]) * (float)(done + i + 1) * fadeStep;
+		}
 
-				case 1:  // MS - Asymmetric diode character
-					u = diodeClip(input * (1.0f + resAmt * 0.5f));
-					break;
+		float peakOut = outputStage(out + done, x, n, replace);
+		if (peakOut > maxOut) maxOut = peakOut;
+	}
 
-				case 2:  // XX - Aggressive saturation
-					u = aggressiveSat(input * (1.0f + resAmt * 2.0f));
-					break;
+	// Filter state decaying after the input stops goes to zero instead of
+	// on through the subnormal range
+	dtc->lp = flushDenormal(dtc->lp);
+	dtc->bp = flushDenormal(dtc->bp);
+	dtc->hp = flushDenormal(dtc->hp);
 
-				default:
-					u = fastTanh(input);
-			}
+	// Store levels for display (with decay); an infinite input sample would
+	// otherwise leave the meter stuck at inf
+	dtc->inputLevel = sanitize(dtc->inputLevel * 0.95f + maxIn * 0.05f);
+	dtc->outputLevel = sanitize(dtc->outputLevel * 0.95f + maxOut * 0.05f);
 
-			// Trapezoidal (TPT) State Variable Filter
-			// This topology is stable and doesn't blow up at high resonance
-			//
-			// hp = (input - k*bp - lp) / (1 + k*g + g*g)
-			// bp_new = g*hp + bp
-			// lp_new = g*bp_new + lp
+	// What Auto judges the next block by
+	dtc->autoPeakIn = maxIn;
+	dtc->autoPeakOut = maxOut;
 
-			float hp = (u - dtc->k * dtc->bp - dtc->lp) * dtc->gInv;
-			float bp = dtc->g * hp + dtc->bp;
-			float lp = dtc->g * bp + dtc->lp;
+	uint32_t ticks = cycleCounterRead() - startTicks;
+	if (osParam < requested)
+		++pThis->cycles.degradedBlocks;
 
-			// Soft clamp states for safety (shouldn't be needed with proper TPT)
-			bp = softClamp(bp, 5.0f);
-			lp = softClamp(lp, 5.0f);
+	// A block that rendered twice for a crossfade says little about the
+	// factor it moved to
+	if (budget > 0.0f && fadeStages < 0)
+		updateGovernor(dtc, cycleLoadPercent(ticks / (uint32_t)numFrames), budget, osParam, minStages);
 
-			// Update state
-			dtc->bp = sanitize(bp);
-			dtc->lp = sanitize(lp);
-			dtc->hp = sanitize(hp);
+	updateCycleStats(&pThis->cycles, ticks, numFrames);
+	floatModeRestore(floatMode);
+}
 
-			// Accumulate output based on mode (for oversampling averaging)
-			switch (mode)
-			{
-				case kFilterModeLowpass:
-					output += lp;
-					break;
-				case kFilterModeBandpass:
-					output += bp;
-					break;
-				case kFilterModeHighpass:
-					output += hp;
-					break;
-				case kFilterModeAllpass:
-					output += lp - hp;
-					break;
-				default:
-					output += lp;
-					break;
-			}
-		}
+/**
+ * Append text to a display string, returns the new end
+ */
+inline char* appendText(char* dst, const char* text)
+{
+	while (*text)
+		*dst++ = *text++;
+	*dst = 0;
+	return dst;
+}
 
-		// Average oversampled output
-		output /= (float)oversample;
+/**
+ * Append an unsigned integer to a display string, returns the new end
+ */
+inline char* appendInt(char* dst, uint32_t value)
+{
+	return dst + NT_intToString(dst, (int32_t)value);
+}
 
-		// Sanitize (catch any NaN/inf)
-		output = sanitize(output);
+/**
+ * Cycle statistics in the empty area left of the response curve
+ */
+void drawDiagnostics(const _tangentsCycleStats* stats)
+{
+	char line[40];
+	char* p;
+
+	// Per block and per sample: min/mean/max over the last window
+	p = appendText(line, "BLK ");
+	p = appendInt(p, stats->blockMin);
+	p = appendText(p, "/");
+	p = appendInt(p, stats->blockMean);
+	p = appendText(p, "/");
+	appendInt(p, stats->blockMax);
+	NT_drawText(5, 22, line, 10, kNT_textLeft, kNT_textTiny);
+
+	p = appendText(line, "SMP ");
+	p = appendInt(p, stats->sampleMin);
+	p = appendText(p, "/");
+	p = appendInt(p, stats->sampleMean);
+	p = appendText(p, "/");
+	appendInt(p, stats->sampleMax);
+	NT_drawText(5, 30, line, 10, kNT_textLeft, kNT_textTiny);
+
+	// Load as % of the block deadline: mean, worst in window, worst since reset
+	p = appendText(line, "CPU ");
+	p = appendInt(p, (uint32_t)(cycleLoadPercent(stats->sampleMean) + 0.5f));
+	p = appendText(p, "% MAX ");
+	p = appendInt(p, (uint32_t)(cycleLoadPercent(stats->sampleMax) + 0.5f));
+	p = appendText(p, "% PK ");
+	p = appendInt(p, (uint32_t)(cycleLoadPercent(stats->samplePeak) + 0.5f));
+	appendText(p, "%");
+	NT_drawText(5, 38, line, 12, kNT_textLeft, kNT_textTiny);
+
+	// Blocks the CPU governor ran below the requested factor since reset
+	p = appendText(line, CYCLE_UNIT);
+	p = appendText(p, " min/avg/max  GOV ");
+	p = appendInt(p, stats->degradedBlocks);
+	appendText(p, " blk");
+	NT_drawText(5, 46, line, 6, kNT_textLeft, kNT_textTiny);
+}
 
-		// Model-specific output saturation
-		switch (model)
-		{
-			case 0:  // YU - Smooth tanh saturation (Yusynth-style)
-				output = fastTanh(output);
-				break;
-			case 1:  // MS - Asymmetric diode clipping
-				output = diodeClip(output);
-				break;
-			case 2:  // XX - Aggressive fold-back distortion
-				output = aggressiveSat(output);
-				break;
-			default:
-				output = fastTanh(output);
-		}
+/**
+ * Approximate magnitude response drawn by draw()
+ * freqRatio is frequency / cutoff, resonance is 0-100
+ * (Hand-tuned for the display; tools/response compares it with the real filter)
+ */
+inline float displayResponse(FilterMode mode, float freqRatio, float resonance)
+{
+	float response;
 
-		// Track output level
-		float absOut = fabsf(output);
-		if (absOut > maxOut) maxOut = absOut;
+	switch (mode)
+	{
+		case kFilterModeLowpass:
+			response = 1.0f / sqrtf(1.0f + freqRatio * freqRatio * freqRatio * freqRatio);
+			break;
+		case kFilterModeBandpass:
+			response = freqRatio / (1.0f + freqRatio * freqRatio);
+			if (resonance > 50.0f) response *= 1.0f + (resonance - 50.0f) / 25.0f;
+			break;
+		case kFilterModeHighpass:
+			response = freqRatio * freqRatio / sqrtf(1.0f + freqRatio * freqRatio * freqRatio * freqRatio);
+			break;
+		case kFilterModeAllpass:
+			response = 0.5f;  // Flat magnitude
+			break;
+		default:
+			response = 0.5f;
+	}
 
-		// Write output
-		if (replace)
-			out[i] = output;
-		else
-			out[i] += output;
+	// Add resonance peak
+	if (resonance > 0 && fabsf(freqRatio - 1.0f) < 0.3f)
+	{
+		float peakBoost = 1.0f + (resonance / 100.0f) * 2.0f * (1.0f - fabsf(freqRatio - 1.0f) / 0.3f);
+		response *= peakBoost;
 	}
 
-	// Store levels for display (with decay)
-	dtc->inputLevel = dtc->inputLevel * 0.95f + maxIn * 0.05f;
-	dtc->outputLevel = dtc->outputLevel * 0.95f + maxOut * 0.05f;
+	return response;
 }
 
 bool draw(_NT_algorithm* self)
@@ -636,6 +2820,32 @@ bool draw(_NT_algorithm* self)
 	FilterMode mode = (FilterMode)pThis->v[kParamMode];
 	NT_drawText(95, 8, modeNames[mode], 12);
 
+	// Oversampling in effect (Auto and the CPU governor: the latest
+	// block's), multirate decimation, and the latency of both
+	int resampler = activeResampler(pThis);
+	int stages = dtc->runStages;
+	int depth = dtc->multirateDepth;
+	float latency = 0.0f;
+	if (stages > 0 && resampler == kResamplerHalfband)
+		latency = halfbandLatency(dtc->halfband, stages);
+	else if (stages > 0 && resampler == kResamplerHalfbandIir)
+		latency = halfbandLatency(dtc->halfbandIir, stages);
+	else if (stages > 0 && (resampler == kResamplerLinear || resampler == kResamplerCubic))
+		latency = interpolationLatency(resampler == kResamplerCubic, stages);
+	latency = latency * (float)(1 << depth) + multirateLatency(depth);
+	char line[24];
+	char* p = appendInt(line, 1u << stages);
+	p = appendText(p, "x ");
+	if (depth > 0)
+	{
+		p = appendText(p - 1, "/");
+		p = appendInt(p, 1u << depth);
+		p = appendText(p, " ");
+	}
+	p += NT_floatToString(p, latency, 1);
+	appendText(p, " smp");
+	NT_drawText(250, 8, line, 8, kNT_textRight, kNT_textTiny);
+
 	// Draw frequency response curve approximation
 	// This is a simplified visualization
 	// Cutoff: integer Hz, Resonance: scaling=1 so /10 for 0-100 range
@@ -656,34 +2866,7 @@ bool draw(_NT_algorithm* self)
 		float xNorm = (float)(x - 100) / 150.0f;
 		float freq = 20.0f * powf(1000.0f, xNorm);  // Log frequency scale
 
-		float freqRatio = freq / cutoff;
-		float response;
-
-		switch (mode)
-		{
-			case kFilterModeLowpass:
-				response = 1.0f / sqrtf(1.0f + freqRatio * freqRatio * freqRatio * freqRatio);
-				break;
-			case kFilterModeBandpass:
-				response = freqRatio / (1.0f + freqRatio * freqRatio);
-				if (resonance > 50.0f) response *= 1.0f + (resonance - 50.0f) / 25.0f;
-				break;
-			case kFilterModeHighpass:
-				response = freqRatio * freqRatio / sqrtf(1.0f + freqRatio * freqRatio * freqRatio * freqRatio);
-				break;
-			case kFilterModeAllpass:
-				response = 0.5f;  // Flat magnitude
-				break;
-			default:
-				response = 0.5f;
-		}
-
-		// Add resonance peak
-		if (resonance > 0 && fabsf(freqRatio - 1.0f) < 0.3f)
-		{
-			float peakBoost = 1.0f + (resonance / 100.0f) * 2.0f * (1.0f - fabsf(freqRatio - 1.0f) / 0.3f);
-			response *= peakBoost;
-		}
+		float response = displayResponse(mode, freq / cutoff, resonance);
 
 		// Clamp and scale to screen
 		if (response > 2.0f) response = 2.0f;
@@ -729,6 +2912,10 @@ bool draw(_NT_algorithm* self)
 	NT_drawText(65, 58, "O", 8);
 	NT_drawShapeI(kNT_rectangle, 72, 56, 72 + outWidth, 60, 12);
 
+	// Execution time of step(), if enabled
+	if (pThis->v[kParamDiagnostics])
+		drawDiagnostics(&pThis->cycles);
+
 	return true;  // We handle all drawing - hide standard top bar
 }
 
@@ -831,8 +3018,8 @@ static const _NT_factory factory =
 	.guid = NT_MULTICHAR('T', 'h', 'T', 'a'),  // Thorinside + Tangents
 	.name = "Tangents",
 	.description = "Steiner-Parker multimode filter",
-	.numSpecifications = 0,
-	.specifications = NULL,
+	.numSpecifications = ARRAY_SIZE(specifications),
+	.specifications = specifications,
 	.calculateStaticRequirements = NULL,
 	.initialise = NULL,
 	.calculateRequirements = calculateRequirements,
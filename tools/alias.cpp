@@ -0,0 +1,215 @@
+/*
+alias - aliasing energy vs CPU cost for each oversample factor and model
+
+Drives step() with high-frequency sines at several drive levels and measures
+how much of the output lands on non-harmonic frequencies, i.e. harmonics of
+the saturators folded back below Nyquist. Test tones sit exactly on an FFT
+bin with an odd bin index (coherent sampling), so every true harmonic falls
+on a multiple of that bin and every folded one does not; no window is needed.
+
+Aliasing is reported as the non-harmonic energy relative to the total output
+energy, in dB, next to the measured cost of the same configuration in
+ns/sample. The summary gives, per model and factor, the aliasing averaged
+over tones and drive levels against the cost, which is the data for choosing
+a factor. -c writes every measurement as CSV for plotting.
+
+Usage:
+  alias [-M mode] [-f cutoff] [-a amplitude] [-c out.csv] [-p param=value ...]
+*/
+
+#include "host.h"
+
+#include <unistd.h>
+
+static const int kFftSize = 8192;
+static const int kSettleFrames = 8192;
+
+// Odd bin indices -> ~5.0, 9.0 and 13.0 kHz at 48 kHz
+static const int toneBins[] = { 853, 1531, 2221 };
+static const int driveLevels[] = { 0, 500, 1000 };
+
+static const int kNumTones = ARRAY_SIZE(toneBins);
+static const int kNumDrives = ARRAY_SIZE(driveLevels);
+
+/**
+ * In-place iterative radix-2 FFT
+ */
+static void fft(std::vector<double>& re, std::vector<double>& im)
+{
+	int n = (int)re.size();
+	for (int i = 1, j = 0; i < n; ++i)
+	{
+		int bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+		{
+			double t = re[i]; re[i] = re[j]; re[j] = t;
+			t = im[i]; im[i] = im[j]; im[j] = t;
+		}
+	}
+	for (int len = 2; len <= n; len <<= 1)
+	{
+		double angle = -2.0 * M_PI / len;
+		for (int i = 0; i < n; i += len)
+		{
+			for (int k = 0; k < len / 2; ++k)
+			{
+				double wr = cos(angle * k), wi = sin(angle * k);
+				int a = i + k, b = i + k + len / 2;
+				double xr = re[b] * wr - im[b] * wi;
+				double xi = re[b] * wi + im[b] * wr;
+				re[b] = re[a] - xr; im[b] = im[a] - xi;
+				re[a] += xr; im[a] += xi;
+			}
+		}
+	}
+}
+
+/**
+ * Non-harmonic (aliased) energy relative to total energy, in dB. DC is
+ * excluded from both; it is an offset from the asymmetric MS saturator, not
+ * aliasing.
+ */
+static double aliasRatioDb(const float* x, int toneBin)
+{
+	std::vector<double> re(x, x + kFftSize), im(kFftSize, 0.0);
+	fft(re, im);
+
+	double total = 0.0, alias = 0.0;
+	for (int k = 1; k <= kFftSize / 2; ++k)
+	{
+		double p = re[k] * re[k] + im[k] * im[k];
+		total += p;
+		if (k % toneBin != 0)
+			alias += p;
+	}
+	if (total <= 0.0)
+		return -300.0;
+	return 10.0 * log10(alias / total + 1e-30);
+}
+
+int main(int argc, char** argv)
+{
+	int mode = kFilterModeLowpass;
+	int cutoff = 12000;
+	float amplitude = 0.5f;
+	const char* csvPath = NULL;
+	std::vector<int> overrideParam, overrideValue;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "M:f:a:c:p:h")) != -1)
+	{
+		switch (opt)
+		{
+			case 'M': mode = atoi(optarg); break;
+			case 'f': cutoff = atoi(optarg); break;
+			case 'a': amplitude = (float)atof(optarg); break;
+			case 'c': csvPath = optarg; break;
+			case 'p':
+			{
+				int p, value;
+				if (sscanf(optarg, "%d=%d", &p, &value) == 2 && p >= 0 && p < kNumParameters)
+				{
+					overrideParam.push_back(p);
+					overrideValue.push_back(value);
+					break;
+				}
+			}
+			// fall through
+			default:
+				fprintf(stderr, "usage: alias [-M mode] [-f cutoff] [-a amplitude] [-c out.csv] [-p param=value]\n");
+				return 1;
+		}
+	}
+
+	FILE* csv = NULL;
+	if (csvPath)
+	{
+		csv = fopen(csvPath, "w");
+		if (!csv)
+		{
+			fprintf(stderr, "Can't create %s\n", csvPath);
+			return 1;
+		}
+		fprintf(csv, "model,oversample,drive,tone_hz,alias_db,ns_per_sample\n");
+	}
+
+	const int total = kSettleFrames + kFftSize;
+	const float rate = (float)NT_globals.sampleRate;
+	std::vector<float> input(total), output(total);
+
+	double summaryAlias[kHostNumModels][kHostNumOversample];
+	double summaryCost[kHostNumModels][kHostNumOversample];
+
+	printf("Mode %s, cutoff %d Hz, amplitude %.2f, %d-point FFT\n\n", hostModeNames[mode], cutoff, amplitude, kFftSize);
+	printf("Model  OS    Drive   Tone Hz   Alias dB   ns/sample\n");
+
+	for (int model = 0; model < kHostNumModels; ++model)
+	{
+		for (int os = 0; os < kHostNumOversample; ++os)
+		{
+			double aliasSum = 0.0, costSum = 0.0;
+
+			for (int d = 0; d < kNumDrives; ++d)
+			{
+				for (int t = 0; t < kNumTones; ++t)
+				{
+					double w = 2.0 * M_PI * toneBins[t] / kFftSize;
+					for (int i = 0; i < total; ++i)
+						input[i] = amplitude * (float)sin(w * i);
+
+					HostPlugin plugin;
+					plugin.create();
+					hostConfigure(plugin, model, mode, os);
+					plugin.set(kParamCutoff, cutoff);
+					plugin.set(kParamDrive, driveLevels[d]);
+					for (size_t j = 0; j < overrideParam.size(); ++j)
+						plugin.set(overrideParam[j], overrideValue[j]);
+
+					plugin.process(&input[0], &output[0], kSettleFrames, kHostDefaultBlockFrames);
+					double start = hostSeconds();
+					plugin.process(&input[kSettleFrames], &output[kSettleFrames], kFftSize, kHostDefaultBlockFrames);
+					double ns = (hostSeconds() - start) * 1e9 / kFftSize;
+
+					double alias = aliasRatioDb(&output[kSettleFrames], toneBins[t]);
+					double hz = (double)toneBins[t] * rate / kFftSize;
+					aliasSum += alias;
+					costSum += ns;
+
+					printf("%-5s  %-4s  %5d  %8.0f   %8.1f   %9.1f\n",
+						hostModelNames[model], hostOversampleNames[os], driveLevels[d], hz, alias, ns);
+					if (csv)
+						fprintf(csv, "%s,%d,%d,%.0f,%.2f,%.2f\n",
+							hostModelNames[model], 1 << os, driveLevels[d], hz, alias, ns);
+				}
+			}
+
+			summaryAlias[model][os] = aliasSum / (kNumDrives * kNumTones);
+			summaryCost[model][os] = costSum / (kNumDrives * kNumTones);
+		}
+	}
+
+	printf("\nSummary (mean over tones and drive levels)\n");
+	printf("Model  OS    Alias dB   ns/sample   dB gained vs 1x   cost vs 1x\n");
+	for (int model = 0; model < kHostNumModels; ++model)
+	{
+		for (int os = 0; os < kHostNumOversample; ++os)
+		{
+			printf("%-5s  %-4s  %8.1f   %9.1f   %15.1f   %9.1fx\n",
+				hostModelNames[model], hostOversampleNames[os],
+				summaryAlias[model][os], summaryCost[model][os],
+				summaryAlias[model][0] - summaryAlias[model][os],
+				summaryCost[model][os] / summaryCost[model][0]);
+		}
+	}
+
+	if (csv)
+	{
+		fclose(csv);
+		printf("\nWrote %s\n", csvPath);
+	}
+
+	return 0;
+}
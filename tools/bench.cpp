@@ -0,0 +1,490 @@
+/*
+bench - microbenchmarks for the per-sample DSP kernels
+
+Times each helper that sits in (or feeds) the inner oversampling loop of
+step() in isolation, over input distributions taken from what step()
+actually feeds it, and reports ns/call and cycles/call. Cycles come from the
+TSC on x86 hosts (reference cycles, not core cycles); elsewhere only ns are
+reported.
+
+Every kernel is run over a precomputed 4096-entry input table, several
+rounds, keeping the fastest round. The "baseline" row is the same loop with
+an identity kernel, i.e. the load/accumulate overhead included in every
+other row.
+
+The block stages step() chains together (input, saturators, SVF, halfband
+up/down) are timed the same way on 128-frame blocks, in ns per base-rate
+sample. Stages that work in place take their input from tables expanded to
+their rate before timing and copy it into the work buffer; the same copy
+timed on its own is subtracted from their rows.
+
+Usage:
+  bench [-r rounds] [-n passesPerRound]
+*/
+
+#include "host.h"
+
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#endif
+
+static const int kTableSize = 4096;
+
+static volatile float benchSink;
+
+inline uint64_t benchCycles()
+{
+#ifdef BENCH_HAVE_TSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+struct BenchResult
+{
+	double ns;
+	double cycles;
+};
+
+/**
+ * Run kernel over the table `passes` times per round and keep the fastest
+ * round. Kernel is any functor float(float).
+ */
+template <typename Kernel>
+static BenchResult benchRun(Kernel kernel, const float* table, int rounds, int passes)
+{
+	BenchResult best = { 1e30, 1e30 };
+	for (int round = 0; round < rounds; ++round)
+	{
+		float acc = 0.0f;
+		double start = hostSeconds();
+		uint64_t c0 = benchCycles();
+		for (int pass = 0; pass < passes; ++pass)
+			for (int i = 0; i < kTableSize; ++i)
+				acc += kernel(table[i]);
+		uint64_t c1 = benchCycles();
+		double elapsed = hostSeconds() - start;
+		benchSink = acc;
+
+		double calls = (double)passes * kTableSize;
+		if (elapsed * 1e9 / calls < best.ns)
+		{
+			best.ns = elapsed * 1e9 / calls;
+			best.cycles = (double)(c1 - c0) / calls;
+		}
+	}
+	return best;
+}
+
+static const int kStageFrames = 128;
+
+/**
+ * Run a block stage over the table in kStageFrames chunks, `passes` times per
+ * round, keeping the fastest round. Stage is any functor
+ * void(const float* in, float* work, int n); a chunk's input is
+ * kStageFrames * factor entries of the table. Results are per base-rate frame.
+ */
+template <typename Stage>
+static BenchResult benchStage(Stage stage, const float* table, int rounds, int passes, int factor = 1)
+{
+	std::vector<float> work(kStageFrames << HALFBAND_MAX_STAGES);
+	BenchResult best = { 1e30, 1e30 };
+	for (int round = 0; round < rounds; ++round)
+	{
+		double start = hostSeconds();
+		uint64_t c0 = benchCycles();
+		for (int pass = 0; pass < passes; ++pass)
+			for (int i = 0; i < kTableSize; i += kStageFrames)
+				stage(table + i * factor, &work[0], kStageFrames);
+		uint64_t c1 = benchCycles();
+		double elapsed = hostSeconds() - start;
+		benchSink = work[0];
+
+		double frames = (double)passes * kTableSize;
+		if (elapsed * 1e9 / frames < best.ns)
+		{
+			best.ns = elapsed * 1e9 / frames;
+			best.cycles = (double)(c1 - c0) / frames;
+		}
+	}
+	return best;
+}
+
+/**
+ * Copy of an in-place stage's input into the work buffer, the part of its
+ * time that is not the stage
+ */
+struct SCopy
+{
+	int factor;
+	void operator()(const float* in, float* work, int n) const { memcpy(work, in, n * factor * sizeof(float)); }
+};
+
+/**
+ * benchStage for a stage that starts with SCopy, less the copy's own time
+ */
+template <typename Stage>
+static BenchResult benchStageInPlace(Stage stage, const float* table, int rounds, int passes, int factor = 1)
+{
+	BenchResult r = benchStage(stage, table, rounds, passes, factor);
+	SCopy copy = { factor };
+	BenchResult c = benchStage(copy, table, rounds, passes, factor);
+	r.ns = (r.ns > c.ns) ? r.ns - c.ns : 0.0;
+	r.cycles = (r.cycles > c.cycles) ? r.cycles - c.cycles : 0.0;
+	return r;
+}
+
+static void benchReport(const char* name, const char* input, const BenchResult& r)
+{
+#ifdef BENCH_HAVE_TSC
+	printf("%-24s %-28s %8.2f %10.1f\n", name, input, r.ns, r.cycles);
+#else
+	printf("%-24s %-28s %8.2f %10s\n", name, input, r.ns, "-");
+#endif
+}
+
+// ============================================================================
+// KERNELS
+// ============================================================================
+
+struct KIdentity { float operator()(float x) const { return x; } };
+struct KFastTanh { float operator()(float x) const { return fastTanh(x); } };
+struct KDiodeClip { float operator()(float x) const { return diodeClip(x); } };
+struct KDiodeClipTable { float operator()(float x) const { return diodeClipTable(x); } };
+struct KAggressiveSat { float operator()(float x) const { return aggressiveSat(x); } };
+struct KSanitize { float operator()(float x) const { return sanitize(x); } };
+struct KSoftClamp { float operator()(float x) const { return softClamp(x, 5.0f); } };
+
+struct KFastRandom
+{
+	uint32_t* state;
+	float operator()(float) const { return fastRandom(*state); }
+};
+
+struct KProcessAGR
+{
+	uint32_t* state;
+	float operator()(float agr) const { return processAGR((int)agr, *state); }
+};
+
+/**
+ * Cutoff comes from the table; resonance and rate are derived from it so the
+ * call sees the same spread of arguments step() does
+ */
+struct KFilterCoeffs
+{
+	_tangentsAlgorithm_DTC* dtc;
+	float operator()(float cutoff) const
+	{
+		float resonance = cutoff * (1.0f / 12000.0f);
+		float rate = 48000.0f * (float)(1 << ((int)cutoff & 3));
+		calculateFilterCoeffs(dtc, cutoff, resonance, rate);
+		return dtc->g;
+	}
+};
+
+// ============================================================================
+// BLOCK STAGES
+// ============================================================================
+
+struct SInput
+{
+	_tangentsAlgorithm_DTC* dtc;
+	void operator()(const float* in, float* work, int n) const { inputStage(dtc, in, work, n); }
+};
+
+struct SSaturateInput
+{
+	const _tangentsKernels* kernels;
+	int factor;
+	_tangentsAdaaState* adaa;
+	void operator()(const float* in, float* work, int n) const
+	{
+		memcpy(work, in, n * factor * sizeof(float));
+		saturateInputBlock(kernels, work, n * factor, 0.5f, adaa);
+	}
+};
+
+struct SSaturateOutput
+{
+	const _tangentsKernels* kernels;
+	_tangentsAdaaState* adaa;
+	void operator()(const float* in, float* work, int n) const
+	{
+		memcpy(work, in, n * sizeof(float));
+		saturateOutputBlock(kernels, work, n, adaa);
+	}
+};
+
+struct SSvfHold
+{
+	const _tangentsKernels* kernels;
+	_tangentsAlgorithm_DTC* dtc;
+	const _tangentsSvfTransition* transition;
+	int factor;
+	void operator()(const float* in, float* work, int n) const
+	{
+		memcpy(work, in, n * sizeof(float));
+		svfHeldBlock(kernels, dtc, transition, work, n, factor);
+	}
+};
+
+struct SSvf
+{
+	const _tangentsKernels* kernels;
+	_tangentsAlgorithm_DTC* dtc;
+	int factor;
+	void operator()(const float* in, float* work, int n) const
+	{
+		memcpy(work, in, n * factor * sizeof(float));
+		kernels->svf(dtc, work, n * factor, kernels->mode);
+	}
+};
+
+struct SInterpolate
+{
+	float* hist;
+	bool cubic;
+	int factor;
+	void operator()(const float* in, float* work, int n) const { interpolateBlock(hist, cubic, in, n, factor, work); }
+};
+
+struct SAverage
+{
+	int factor;
+	void operator()(const float* in, float* work, int n) const
+	{
+		memcpy(work, in, n * factor * sizeof(float));
+		averageBlock(work, n, factor, work);
+	}
+};
+
+template <class Stage>
+struct SHalfbandUp
+{
+	Stage* stages;
+	int numStages;
+	void operator()(const float* in, float* work, int n) const { halfbandUpsampleBlock(stages, numStages, in, n, work); }
+};
+
+template <class Stage>
+struct SHalfbandDown
+{
+	Stage* stages;
+	int numStages;
+	void operator()(const float* in, float* work, int n) const
+	{
+		memcpy(work, in, (n << numStages) * sizeof(float));
+		halfbandDownsampleBlock(stages, numStages, work, n, work);
+	}
+};
+
+// ============================================================================
+// INPUT DISTRIBUTIONS
+// ============================================================================
+
+/**
+ * Saturator argument in step(): audio (noise mix of sines, up to 0 dBFS-ish)
+ * times AGR (0.5 - 4) times drive (1 - 5) times the model's resonance gain
+ */
+static void tableSaturatorInput(float* t, uint32_t seed)
+{
+	uint32_t state = seed;
+	for (int i = 0; i < kTableSize; ++i)
+	{
+		float audio = 0.6f * sinf(i * 0.031f) + 0.4f * (2.0f * fastRandom(state) - 1.0f);
+		float gain = (0.5f + 3.5f * fastRandom(state)) * (1.0f + 4.0f * fastRandom(state));
+		t[i] = audio * gain * (1.0f + fastRandom(state));
+	}
+}
+
+/**
+ * Filter state right before softClamp/sanitize: mostly well inside ±5, with
+ * occasional excursions past the clamp when resonance is high
+ */
+static void tableFilterState(float* t, uint32_t seed)
+{
+	uint32_t state = seed;
+	for (int i = 0; i < kTableSize; ++i)
+	{
+		float x = 2.0f * fastRandom(state) - 1.0f;
+		t[i] = (fastRandom(state) < 0.05f) ? x * 8.0f : x * 3.0f;
+	}
+}
+
+static void tableRange(float* t, float lo, float hi, uint32_t seed)
+{
+	uint32_t state = seed;
+	for (int i = 0; i < kTableSize; ++i)
+		t[i] = lo + (hi - lo) * fastRandom(state);
+}
+
+/**
+ * Cutoff in Hz, log-distributed across the parameter range
+ */
+static void tableCutoff(float* t, uint32_t seed)
+{
+	uint32_t state = seed;
+	for (int i = 0; i < kTableSize; ++i)
+		t[i] = 20.0f * powf(600.0f, fastRandom(state));
+}
+
+int main(int argc, char** argv)
+{
+	int rounds = 7;
+	int passes = 64;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "r:n:h")) != -1)
+	{
+		switch (opt)
+		{
+			case 'r': rounds = atoi(optarg); break;
+			case 'n': passes = atoi(optarg); break;
+			default:
+				fprintf(stderr, "usage: bench [-r rounds] [-n passesPerRound]\n");
+				return 1;
+		}
+	}
+
+	std::vector<float> sat(kTableSize), state(kTableSize), agrRandom(kTableSize),
+		agrAtten(kTableSize), agrAmp(kTableSize), cutoff(kTableSize);
+	tableSaturatorInput(&sat[0], 0x1234567);
+	tableFilterState(&state[0], 0x89ABCDE);
+	tableRange(&agrRandom[0], 0.0f, 25.0f, 0x1111);
+	tableRange(&agrAtten[0], 26.0f, 50.0f, 0x2222);
+	tableRange(&agrAmp[0], 51.0f, 100.0f, 0x3333);
+	tableCutoff(&cutoff[0], 0x4444);
+
+	// Saturator input held at each oversampled rate, and scaled to the level
+	// the SVF sees, for the in-place stages
+	std::vector<float> held[HALFBAND_MAX_STAGES + 1], svfIn[HALFBAND_MAX_STAGES + 1];
+	for (int os = 0; os <= HALFBAND_MAX_STAGES; ++os)
+	{
+		held[os].resize(kTableSize << os);
+		svfIn[os].resize(kTableSize << os);
+		for (int i = 0; i < (kTableSize << os); ++i)
+		{
+			held[os][i] = sat[i >> os];
+			svfIn[os][i] = 0.1f * sat[i >> os];
+		}
+	}
+
+	uint32_t randState = 0x12345678;
+	_tangentsAlgorithm_DTC dtc;
+	memset(&dtc, 0, sizeof(dtc));
+
+	KFastRandom kRandom = { &randState };
+	KProcessAGR kAGR = { &randState };
+	KFilterCoeffs kCoeffs = { &dtc };
+
+	printf("%d rounds x %d passes x %d calls, best round\n\n", rounds, passes, kTableSize);
+#ifdef BENCH_HAVE_TSC
+	printf("%-24s %-28s %8s %10s\n", "Kernel", "Input", "ns/call", "TSC/call");
+#else
+	printf("%-24s %-28s %8s %10s\n", "Kernel", "Input", "ns/call", "cyc/call");
+#endif
+
+	benchReport("baseline", "saturator input", benchRun(KIdentity(), &sat[0], rounds, passes));
+	benchReport("fastTanh", "saturator input", benchRun(KFastTanh(), &sat[0], rounds, passes));
+	benchReport("diodeClip", "saturator input", benchRun(KDiodeClip(), &sat[0], rounds, passes));
+	benchReport("diodeClipTable", "saturator input", benchRun(KDiodeClipTable(), &sat[0], rounds, passes));
+	benchReport("aggressiveSat", "saturator input", benchRun(KAggressiveSat(), &sat[0], rounds, passes));
+	benchReport("sanitize", "filter state", benchRun(KSanitize(), &state[0], rounds, passes));
+	benchReport("softClamp", "filter state", benchRun(KSoftClamp(), &state[0], rounds, passes));
+	benchReport("fastRandom", "-", benchRun(kRandom, &sat[0], rounds, passes));
+	benchReport("processAGR", "random zone (0-25)", benchRun(kAGR, &agrRandom[0], rounds, passes));
+	benchReport("processAGR", "attenuation zone (26-50)", benchRun(kAGR, &agrAtten[0], rounds, passes));
+	benchReport("processAGR", "amplification zone (51-100)", benchRun(kAGR, &agrAmp[0], rounds, passes));
+	benchReport("calculateFilterCoeffs", "20 Hz - 12 kHz, 1x-8x", benchRun(kCoeffs, &cutoff[0], rounds, passes / 8 + 1));
+
+	// Block stages at 1 kHz cutoff, 50% resonance; ns per base-rate frame
+	printf("\n%-24s %-28s %8s %10s\n", "Stage", "Setup", "ns/frame", "");
+	_tangentsHalfbandStage halfband[HALFBAND_MAX_STAGES];
+	memset(halfband, 0, sizeof(halfband));
+	_tangentsHalfbandIirStage halfbandIir[HALFBAND_MAX_STAGES];
+	memset(halfbandIir, 0, sizeof(halfbandIir));
+	dtc.agrSmooth = 50.0f;
+	dtc.driveSmooth = 2.0f;
+	dtc.randState = 0x12345678;
+	SInput sInput = { &dtc };
+	benchReport("inputStage", "unity AGR", benchStage(sInput, &sat[0], rounds, passes));
+
+	static const char* const factorNames[] = { "1x", "2x", "4x", "8x", "16x" };
+
+	// Lowpass SVF kernels as step() selects them, and the ones that switch
+	// on the mode per substep (what the other modes run with KERNELS=hot)
+	_tangentsKernels lowpass;
+	selectKernels(&lowpass, 0, kFilterModeLowpass, false);
+	_tangentsKernels perSubstep = lowpass;
+	perSubstep.svf = svfBlock;
+	perSubstep.svfHold = svfHoldBlock;
+
+	// The models, then MS with Saturator = Table
+	for (int m = 0; m <= kHostNumModels; ++m)
+	{
+		int model = (m < kHostNumModels) ? m : MODEL_MS_TABLE;
+		const char* name = (m < kHostNumModels) ? hostModelNames[m] : "MS table";
+		char setup[64];
+		_tangentsAdaaState adaa = { 0.0f, 0.0f };
+		_tangentsKernels plain, antialiased;
+		selectKernels(&plain, model, kFilterModeLowpass, false);
+		selectKernels(&antialiased, model, kFilterModeLowpass, true);
+		SSaturateInput sSat = { &plain, 1, NULL };
+		SSaturateOutput sOut = { &plain, NULL };
+		SSaturateInput sSatAdaa = { &antialiased, 1, &adaa };
+		SSaturateOutput sOutAdaa = { &antialiased, &adaa };
+		sprintf(setup, "%s", name);
+		benchReport("saturateInputBlock", setup, benchStageInPlace(sSat, &sat[0], rounds, passes));
+		benchReport("saturateOutputBlock", setup, benchStageInPlace(sOut, &sat[0], rounds, passes));
+		sprintf(setup, "%s ADAA", name);
+		benchReport("saturateInputBlock", setup, benchStageInPlace(sSatAdaa, &sat[0], rounds, passes));
+		benchReport("saturateOutputBlock", setup, benchStageInPlace(sOutAdaa, &sat[0], rounds, passes));
+	}
+
+	for (int os = 0; os <= HALFBAND_MAX_STAGES; ++os)
+	{
+		int factor = 1 << os;
+		calculateFilterCoeffs(&dtc, 1000.0f, 0.5f, 48000.0f * factor);
+		dtc.lp = dtc.bp = dtc.hp = 0.0f;
+		_tangentsSvfTransition transition;
+		calculateSvfTransition(&transition, &dtc, kFilterModeLowpass, factor);
+
+		SSvfHold sHold = { &lowpass, &dtc, os > 0 ? &transition : NULL, factor };
+		SSvfHold sHoldSwitch = { &perSubstep, &dtc, os > 0 ? &transition : NULL, factor };
+		SSvf sSvf = { &lowpass, &dtc, factor };
+		SSvf sSvfSwitch = { &perSubstep, &dtc, factor };
+		SHalfbandUp<_tangentsHalfbandStage> sUp = { halfband, os };
+		SHalfbandDown<_tangentsHalfbandStage> sDown = { halfband, os };
+		SHalfbandUp<_tangentsHalfbandIirStage> sUpIir = { halfbandIir, os };
+		SHalfbandDown<_tangentsHalfbandIirStage> sDownIir = { halfbandIir, os };
+		float hist[3] = { 0.0f, 0.0f, 0.0f };
+		SInterpolate sLinear = { hist, false, factor };
+		SInterpolate sCubic = { hist, true, factor };
+		SAverage sAverage = { factor };
+		char setup[64];
+		benchReport("svfHoldBlock", factorNames[os], benchStageInPlace(sHold, &svfIn[0][0], rounds, passes));
+		sprintf(setup, "%s mode per substep", factorNames[os]);
+		benchReport("svfHoldBlock", setup, benchStageInPlace(sHoldSwitch, &svfIn[0][0], rounds, passes));
+		if (os == 0)
+			continue;
+		benchReport("svfBlock", factorNames[os], benchStageInPlace(sSvf, &svfIn[os][0], rounds, passes, factor));
+		benchReport("svfBlock", setup, benchStageInPlace(sSvfSwitch, &svfIn[os][0], rounds, passes, factor));
+		benchReport("halfbandUpsampleBlock", factorNames[os], benchStage(sUp, &sat[0], rounds, passes));
+		benchReport("halfbandDownsampleBlock", factorNames[os], benchStageInPlace(sDown, &held[os][0], rounds, passes, factor));
+		sprintf(setup, "%s IIR", factorNames[os]);
+		benchReport("halfbandUpsampleBlock", setup, benchStage(sUpIir, &sat[0], rounds, passes));
+		benchReport("halfbandDownsampleBlock", setup, benchStageInPlace(sDownIir, &held[os][0], rounds, passes, factor));
+		sprintf(setup, "%s linear", factorNames[os]);
+		benchReport("interpolateBlock", setup, benchStage(sLinear, &sat[0], rounds, passes));
+		sprintf(setup, "%s cubic", factorNames[os]);
+		benchReport("interpolateBlock", setup, benchStage(sCubic, &sat[0], rounds, passes));
+		benchReport("averageBlock", factorNames[os], benchStageInPlace(sAverage, &held[os][0], rounds, passes, factor));
+	}
+
+	return 0;
+}
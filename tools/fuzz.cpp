@@ -0,0 +1,338 @@
+/*
+fuzz - stability and NaN fuzzer for step(), with timing capture
+
+Runs episodes of randomly automated parameters, random block sizes
+(numFramesBy4 from 1 up to the maximum block) and random audio/CV content,
+and flags:
+
+  - NaN/Inf anywhere in the output
+  - poisoned state: non-finite filter state, coefficients, smoothed
+    parameters or display levels left behind in the DTC
+  - filter states pinned at the ±5 softClamp limits after a block
+  - blocks more than -t times slower than the median of blocks with the
+    same oversample factor and resampler and a similar (power-of-two
+    bucket) size
+
+It also counts, per sample, how often each softClamp/sanitize guard in the
+hot loop actually changed a value (TANGENTS_GUARD_STATS). Episodes run in two
+phases: "sane" (finite audio within ±10, CV within ±1) and "hostile" (adds
+huge, subnormal, infinite and NaN content on audio and CV busses), so the
+report shows whether a guard ever fires on well-formed input.
+
+Every finding is printed with the seed of its episode and the block index;
+rerun with -s <seed> -e 1 to reproduce it.
+
+Usage:
+  fuzz [-e episodes] [-n blocksPerEpisode] [-s seed] [-t slowFactor] [-q]
+*/
+
+#define TANGENTS_GUARD_STATS
+#include "host.h"
+
+#include <unistd.h>
+#include <algorithm>
+
+static const int kMaxBlockFrames = 256;
+static const int kMaxFindingsPerKind = 4;
+
+enum
+{
+	kPhaseSane,
+	kPhaseHostile,
+	kNumPhases
+};
+
+static const char* const phaseNames[] = { "sane", "hostile" };
+
+enum
+{
+	kFindingNonFinite,
+	kFindingPoisoned,
+	kFindingSlow,
+	kNumFindingKinds
+};
+
+static const int kNumSizeBuckets = 8;     // 4..7, 8..15, ... 256 frames
+
+struct FuzzPhaseStats
+{
+	uint32_t episodes;
+	uint32_t blocks;
+	uint32_t samples;
+	uint32_t nonFiniteBlocks;
+	uint32_t poisonedEpisodes;
+	uint32_t pinnedBlocks;
+	uint32_t slowBlocks;
+	_tangentsGuardStats guards;
+	std::vector<double> cost;       // ns per block
+	std::vector<int> bucket;        // oversampling setup x block size bucket
+};
+
+static int findingsShown[kNumPhases][kNumFindingKinds];
+static int findingsTotal;
+
+static void fuzzFinding(bool quiet, int phase, int kind, uint32_t seed, int block, const char* what)
+{
+	++findingsTotal;
+	if (quiet || findingsShown[phase][kind] > kMaxFindingsPerKind)
+		return;
+	if (findingsShown[phase][kind]++ == kMaxFindingsPerKind)
+		printf("  [%s] (more of this kind not shown)\n", phaseNames[phase]);
+	else
+		printf("  [%s] seed %u block %d: %s\n", phaseNames[phase], seed, block, what);
+}
+
+static const int kNumOversampleSetups = (kHostNumOversample + 1) * kNumResamplers;   // incl. Auto, x Resampler
+
+static int fuzzBucket(const HostPlugin& plugin, int numFrames)
+{
+	int size = 0;
+	while ((8 << size) <= numFrames && size < kNumSizeBuckets - 1)
+		++size;
+	int setup = plugin.v[kParamOversample] + (kHostNumOversample + 1) * plugin.v[kParamResampler];
+	return setup * kNumSizeBuckets + size;
+}
+
+static bool isFinite(float x)
+{
+	return x == x && x < 1e30f && x > -1e30f;
+}
+
+/**
+ * A signal value for one sample of the given content type
+ */
+static float fuzzValue(int type, float level, int i, uint32_t& rng)
+{
+	switch (type)
+	{
+		case 0: return 0.0f;
+		case 1: return level * (2.0f * fastRandom(rng) - 1.0f);
+		case 2: return (i & 1) ? level : -level;
+		case 3: return level;
+		case 4: return level * sinf(0.01f * (float)i);
+		// Hostile only
+		case 5: return 1e-39f * (2.0f * fastRandom(rng) - 1.0f);
+		case 6: return 1e20f * (2.0f * fastRandom(rng) - 1.0f);
+		case 7: return (fastRandom(rng) < 0.5f) ? INFINITY : -INFINITY;
+		case 8: return NAN;
+		default: return (fastRandom(rng) < 0.01f) ? NAN : level;
+	}
+}
+
+static int fuzzType(bool hostile, uint32_t& rng)
+{
+	// Hostile blocks mostly stay sane so the state has something to poison
+	if (hostile && fastRandom(rng) < 0.3f)
+		return 5 + (int)(fastRandom(rng) * 4.99f);
+	return (int)(fastRandom(rng) * 4.99f);
+}
+
+static void fuzzEpisode(FuzzPhaseStats& stats, int phase, uint32_t seed, int blocks, bool quiet)
+{
+	uint32_t rng = seed;
+	bool hostile = phase == kPhaseHostile;
+	char what[128];
+
+	// Random specifications, so every memory layout is exercised
+	int32_t specs[kNumSpecifications];
+	for (int i = 0; i < kNumSpecifications; ++i)
+	{
+		const _NT_specification& def = specifications[i];
+		specs[i] = def.min + (int)(fastRandom(rng) * (def.max - def.min) + 0.5f);
+	}
+
+	HostPlugin plugin;
+	plugin.create(specs);
+	plugin.set(kParamInput, 1);
+	plugin.set(kParamOutputMode, 1);
+
+	// Every automatable parameter except routing gets a random start value
+	for (int p = kParamCutoff; p < kNumParameters; ++p)
+	{
+		if (p == kParamCvCutoff || p == kParamCvResonance)
+			continue;
+		const _NT_parameter& def = parameters[p];
+		plugin.set(p, def.min + (int)(fastRandom(rng) * (def.max - def.min) + 0.5f));
+	}
+	plugin.set(kParamCvCutoff, fastRandom(rng) < 0.7f ? 2 : 0);
+	plugin.set(kParamCvResonance, fastRandom(rng) < 0.7f ? 3 : 0);
+
+	_tangentsAlgorithm_DTC* dtc = ((_tangentsAlgorithm*)plugin.alg)->dtc;
+	bool poisoned = false;
+
+	for (int b = 0; b < blocks; ++b)
+	{
+		// Parameter automation
+		if (fastRandom(rng) < 0.2f)
+		{
+			int p = kParamCutoff + (int)(fastRandom(rng) * (kNumParameters - kParamCutoff - 0.01f));
+			if (p != kParamCvCutoff && p != kParamCvResonance)
+			{
+				const _NT_parameter& def = parameters[p];
+				plugin.set(p, def.min + (int)(fastRandom(rng) * (def.max - def.min) + 0.5f));
+			}
+		}
+
+		int numFrames = 4 * (1 + (int)(fastRandom(rng) * (kMaxBlockFrames / 4 - 1)));
+
+		int audioType = fuzzType(hostile, rng);
+		int cvCutType = fuzzType(hostile, rng);
+		int cvResType = fuzzType(hostile, rng);
+		float level = 10.0f * fastRandom(rng);
+		float* in = plugin.bus(1, numFrames);
+		float* cvCut = plugin.bus(2, numFrames);
+		float* cvRes = plugin.bus(3, numFrames);
+		for (int i = 0; i < numFrames; ++i)
+		{
+			in[i] = fuzzValue(audioType, level, i, rng);
+			cvCut[i] = fuzzValue(cvCutType, 1.0f, i, rng);
+			cvRes[i] = fuzzValue(cvResType, 1.0f, i, rng);
+		}
+
+		double start = hostSeconds();
+		plugin.step(numFrames);
+		double ns = (hostSeconds() - start) * 1e9;
+
+		stats.blocks++;
+		stats.samples += numFrames;
+		stats.cost.push_back(ns);
+		stats.bucket.push_back(fuzzBucket(plugin, numFrames));
+
+		const float* out = plugin.bus(plugin.v[kParamOutput], numFrames);
+		for (int i = 0; i < numFrames; ++i)
+		{
+			if (!isFinite(out[i]))
+			{
+				stats.nonFiniteBlocks++;
+				sprintf(what, "non-finite output at frame %d (%g)", i, out[i]);
+				fuzzFinding(quiet, phase, kFindingNonFinite, seed, b, what);
+				break;
+			}
+		}
+
+		if (fabsf(dtc->lp) >= 5.0f || fabsf(dtc->bp) >= 5.0f)
+			stats.pinnedBlocks++;
+
+		const float state[] = {
+			dtc->lp, dtc->bp, dtc->hp, dtc->g, dtc->k, dtc->gInv,
+			dtc->cutoffSmooth, dtc->resonanceSmooth, dtc->driveSmooth, dtc->agrSmooth,
+			dtc->cvCutoffAmtSmooth, dtc->cvResAmtSmooth, dtc->inputLevel, dtc->outputLevel,
+			dtc->multirateIn, dtc->multirateOut
+		};
+		static const char* const stateNames[] = {
+			"lp", "bp", "hp", "g", "k", "gInv",
+			"cutoffSmooth", "resonanceSmooth", "driveSmooth", "agrSmooth",
+			"cvCutoffAmtSmooth", "cvResAmtSmooth", "inputLevel", "outputLevel",
+			"multirateIn", "multirateOut"
+		};
+		for (size_t j = 0; j < ARRAY_SIZE(state) && !poisoned; ++j)
+		{
+			if (!isFinite(state[j]))
+			{
+				poisoned = true;
+				sprintf(what, "%s became non-finite (%g)", stateNames[j], state[j]);
+				fuzzFinding(quiet, phase, kFindingPoisoned, seed, b, what);
+			}
+		}
+	}
+
+	stats.episodes++;
+	if (poisoned)
+		stats.poisonedEpisodes++;
+}
+
+int main(int argc, char** argv)
+{
+	int episodes = 200;
+	int blocks = 200;
+	uint32_t seed = 1;
+	double slowFactor = 10.0;
+	bool quiet = false;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "e:n:s:t:qh")) != -1)
+	{
+		switch (opt)
+		{
+			case 'e': episodes = atoi(optarg); break;
+			case 'n': blocks = atoi(optarg); break;
+			case 's': seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 't': slowFactor = atof(optarg); break;
+			case 'q': quiet = true; break;
+			default:
+				fprintf(stderr, "usage: fuzz [-e episodes] [-n blocksPerEpisode] [-s seed] [-t slowFactor] [-q]\n");
+				return 1;
+		}
+	}
+
+	NT_globals.maxFramesPerStep = kMaxBlockFrames;
+
+	FuzzPhaseStats stats[kNumPhases];
+	printf("%d episodes x %d blocks per phase, seeds from %u\n\nFindings:\n", episodes, blocks, seed);
+
+	for (int phase = 0; phase < kNumPhases; ++phase)
+	{
+		FuzzPhaseStats& st = stats[phase];
+		st.episodes = st.blocks = st.samples = 0;
+		st.nonFiniteBlocks = st.poisonedEpisodes = st.pinnedBlocks = st.slowBlocks = 0;
+
+		memset(&tangentsGuardStats, 0, sizeof(tangentsGuardStats));
+		for (int e = 0; e < episodes; ++e)
+		{
+			uint32_t episodeSeed = seed + (uint32_t)e;
+			fuzzEpisode(st, phase, episodeSeed ? episodeSeed : 1, blocks, quiet);
+		}
+		st.guards = tangentsGuardStats;
+
+		// Median cost per bucket, then flag outliers within their bucket
+		int numBuckets = kNumSizeBuckets * kNumOversampleSetups;
+		std::vector<double> median(numBuckets, 0.0);
+		for (int k = 0; k < numBuckets; ++k)
+		{
+			std::vector<double> costs;
+			for (size_t i = 0; i < st.cost.size(); ++i)
+				if (st.bucket[i] == k)
+					costs.push_back(st.cost[i]);
+			if (costs.empty())
+				continue;
+			std::sort(costs.begin(), costs.end());
+			median[k] = costs[costs.size() / 2];
+		}
+		for (size_t i = 0; i < st.cost.size(); ++i)
+		{
+			double m = median[st.bucket[i]];
+			if (st.cost[i] > slowFactor * m)
+			{
+				st.slowBlocks++;
+				char what[96];
+				sprintf(what, "slow block, %.1fx the median cost", st.cost[i] / m);
+				fuzzFinding(quiet, phase, kFindingSlow, seed + (uint32_t)(i / blocks), (int)(i % blocks), what);
+			}
+		}
+	}
+	if (findingsTotal == 0)
+		printf("  none\n");
+
+	printf("\n%-28s %12s %12s\n", "", phaseNames[0], phaseNames[1]);
+#define ROW(label, field) \
+	printf("%-28s %12u %12u\n", label, (unsigned)stats[0].field, (unsigned)stats[1].field)
+	ROW("blocks", blocks);
+	ROW("samples", samples);
+	ROW("blocks with NaN/Inf output", nonFiniteBlocks);
+	ROW("episodes with poisoned state", poisonedEpisodes);
+	ROW("blocks ending pinned at ±5", pinnedBlocks);
+	ROW("slow blocks", slowBlocks);
+	printf("\nGuard fired (per substep / sample):\n");
+	ROW("  softClamp bp", guards.clampBp);
+	ROW("  softClamp lp", guards.clampLp);
+	ROW("  sanitize bp", guards.sanitizeBp);
+	ROW("  sanitize lp", guards.sanitizeLp);
+	ROW("  sanitize hp", guards.sanitizeHp);
+	ROW("  sanitize output", guards.sanitizeOutput);
+	ROW("  sanitize input", guards.sanitizeInput);
+#undef ROW
+
+	bool failed = stats[0].nonFiniteBlocks || stats[1].nonFiniteBlocks ||
+	              stats[0].poisonedEpisodes || stats[1].poisonedEpisodes;
+	return failed ? 1 : 0;
+}
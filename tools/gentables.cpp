@@ -0,0 +1,309 @@
+/*
+gentables - generator of the constant tables compiled into the plugin
+
+Run by the Makefile on the build host before anything that includes
+tangents.cpp is compiled; writes tangents_tables.h (to stdout) with every
+table the DSP reads but never writes, as initialised const arrays. They end
+up in the plugin's read-only data: nothing is computed when the plugin is
+loaded or an instance is constructed, and every build from the same sources
+carries the same tables.
+
+Everything is computed in double precision and printed with enough digits
+to round-trip the float. The designs:
+
+  prewarp       tan(pi r) for r = fc / fs in steps of 1/4096 up to 0.45
+  exp2          2^(j/256) for one octave, and 2^k for k = -10..10
+  diode curve   cubic Hermite through diodeClip's values and slopes at
+                nodes every 1/8 over [-6, 12], with its antiderivative
+  halfband FIR  Kaiser-windowed halfband (centre tap 0.5), odd taps only
+  halfband IIR  elliptic polyphase allpass halfbands from the transition
+                width (Valenzuela-Constantinides)
+
+tools/tables.cpp checks the compiled-in tables against their reference
+functions and specifications (make tables).
+
+Usage:
+  gentables > tangents_tables.h
+*/
+
+#include <math.h>
+#include <stdio.h>
+
+static const double kPi = 3.14159265358979323846;
+
+// Prewarp: entries per unit of fc / fs, and entries up to 0.45 plus one
+static const int kPrewarpResolution = 4096;
+static const int kPrewarpEntries = 1845;
+
+// exp2: steps per octave and octaves either side of 0
+static const int kExp2Resolution = 256;
+static const int kExp2Octaves = 10;
+
+// Diode curve: domain and intervals per unit
+static const int kDiodeMin = -6;
+static const int kDiodeMax = 12;
+static const int kDiodeResolution = 8;
+
+/**
+ * Print a float constant so that it reads back as the same float
+ */
+static void printFloat(double value)
+{
+	float f = (float)value;
+	if (f == 0.0f)
+		f = 0.0f;   // no "-0"
+	char text[32];
+	snprintf(text, sizeof(text), "%.9g", f);
+	bool plain = true;
+	for (const char* p = text; *p; ++p)
+		if (*p == '.' || *p == 'e' || *p == 'n' || *p == 'i')
+			plain = false;
+	printf("%s%sf", text, plain ? ".0" : "");
+}
+
+/**
+ * Print a float array, `perLine` values to a line
+ */
+static void printArray(const char* name, const double* values, int n, int perLine)
+{
+	printf("static const float %s[%d] = {\n", name, n);
+	for (int i = 0; i < n; ++i)
+	{
+		printf((i % perLine == 0) ? "\t" : " ");
+		printFloat(values[i]);
+		printf((i % perLine == perLine - 1 || i == n - 1) ? ",\n" : ",");
+	}
+	printf("};\n\n");
+}
+
+// ============================================================================
+// DESIGNS
+// ============================================================================
+
+/**
+ * Modified Bessel function of the first kind, order 0 (Kaiser window)
+ */
+static double besselI0(double x)
+{
+	double sum = 1.0;
+	double term = 1.0;
+	for (int k = 1; term > 1e-21 * sum; ++k)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+/**
+ * Odd taps a_i (offsets ±(2i - 1) from the centre) of a Kaiser-windowed
+ * halfband FIR of 4 * numCoeffs - 1 taps
+ */
+static void designHalfbandFir(double* coeffs, int numCoeffs, double beta)
+{
+	int half = 2 * numCoeffs - 1;   // offset of the outermost tap
+	for (int i = 1; i <= numCoeffs; ++i)
+	{
+		int n = 2 * i - 1;
+		double r = (double)n / (double)half;
+		double window = besselI0(beta * sqrt(1.0 - r * r)) / besselI0(beta);
+		double sinc = sin(kPi * n / 2.0) / (kPi * n);
+		coeffs[i - 1] = sinc * window;
+	}
+}
+
+/**
+ * Allpass coefficients of an elliptic polyphase IIR halfband with
+ * `numCoeffs` first-order sections and the given transition width (as a
+ * fraction of the higher rate's Nyquist band), ascending, so that they
+ * alternate between the two branches
+ */
+static void designHalfbandIir(double* coeffs, int numCoeffs, double transition)
+{
+	double k = tan((1.0 - transition * 2.0) * kPi / 4.0);
+	k *= k;
+	double kksqrt = pow(1.0 - k * k, 0.25);
+	double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+	double e4 = e * e * e * e;
+	double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+	int order = numCoeffs * 2 + 1;
+
+	for (int index = 0; index < numCoeffs; ++index)
+	{
+		int c = index + 1;
+
+		double num = 0.0;
+		double term;
+		int sign = 1;
+		int i = 0;
+		do
+		{
+			term = pow(q, (double)(i * (i + 1))) * sin((i * 2 + 1) * c * kPi / order) * sign;
+			num += term;
+			sign = -sign;
+			++i;
+		} while (fabs(term) > 1e-100);
+		num *= pow(q, 0.25);
+
+		double den = 0.0;
+		sign = -1;
+		i = 1;
+		do
+		{
+			term = pow(q, (double)(i * i)) * cos(i * 2 * c * kPi / order) * sign;
+			den += term;
+			sign = -sign;
+			++i;
+		} while (fabs(term) > 1e-100);
+		den += 0.5;
+
+		double ww = num / den;
+		double wwsq = ww * ww;
+		double x = sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+		coeffs[index] = (1.0 - x) / (1.0 + x);
+	}
+}
+
+/**
+ * diodeClip (tangents.cpp) and its slope
+ */
+static double diodeCurve(double x)
+{
+	return (x > 0.0) ? 1.0 - exp(-x) : -0.5 * (1.0 - exp(2.0 * x));
+}
+
+static double diodeSlope(double x)
+{
+	return (x > 0.0) ? exp(-x) : exp(2.0 * x);
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+static void printPrewarp()
+{
+	static double table[kPrewarpEntries];
+	for (int i = 0; i < kPrewarpEntries; ++i)
+		table[i] = tan(kPi * (double)i / (double)kPrewarpResolution);
+
+	printf("// g = tan(pi r) at r = i / PREWARP_TABLE_RESOLUTION, up to 0.45 and one beyond\n");
+	printf("static const float PREWARP_TABLE_RESOLUTION = %d.0f;\n", kPrewarpResolution);
+	printf("static const int PREWARP_TABLE_ENTRIES = %d;\n\n", kPrewarpEntries);
+	printArray("prewarpTable", table, kPrewarpEntries, 6);
+}
+
+static void printExp2()
+{
+	static double fraction[kExp2Resolution + 1];
+	static double octave[2 * kExp2Octaves + 1];
+	for (int j = 0; j <= kExp2Resolution; ++j)
+		fraction[j] = pow(2.0, (double)j / (double)kExp2Resolution);
+	for (int k = 0; k <= 2 * kExp2Octaves; ++k)
+		octave[k] = ldexp(1.0, k - kExp2Octaves);
+
+	printf("// 2^x for x in [-EXP2_TABLE_OCTAVES, EXP2_TABLE_OCTAVES]: 2^(j / EXP2_TABLE_RESOLUTION)\n");
+	printf("// across one octave, and the whole octaves from 2^-EXP2_TABLE_OCTAVES\n");
+	printf("static const int EXP2_TABLE_RESOLUTION = %d;\n", kExp2Resolution);
+	printf("static const int EXP2_TABLE_OCTAVES = %d;\n\n", kExp2Octaves);
+	printArray("exp2FractionTable", fraction, kExp2Resolution + 1, 6);
+	printArray("exp2OctaveTable", octave, 2 * kExp2Octaves + 1, 6);
+}
+
+static void printDiode()
+{
+	const int intervals = (kDiodeMax - kDiodeMin) * kDiodeResolution;
+	const double h = 1.0 / (double)kDiodeResolution;
+
+	printf("// Diode curve: cubic per interval of 1 / DIODE_TABLE_RESOLUTION over\n");
+	printf("// [DIODE_TABLE_MIN, DIODE_TABLE_MAX], in the position u within it\n");
+	printf("static const float DIODE_TABLE_MIN = %d.0f;\n", kDiodeMin);
+	printf("static const float DIODE_TABLE_MAX = %d.0f;\n", kDiodeMax);
+	printf("static const float DIODE_TABLE_RESOLUTION = %d.0f;\n", kDiodeResolution);
+	printf("static const int DIODE_TABLE_INTERVALS = %d;\n\n", intervals);
+	printf("struct _tangentsSaturatorInterval\n{\n");
+	printf("\tfloat c0, c1, c2, c3;   // curve = c0 + c1 u + c2 u^2 + c3 u^3, u in [0, 1]\n");
+	printf("\tfloat F;                // antiderivative at u = 0, zero at x = 0\n");
+	printf("};\n\n");
+
+	// Antiderivative of the interpolant at each node, zero at x = 0
+	double F[(kDiodeMax - kDiodeMin) * kDiodeResolution + 1];
+	F[0] = 0.0;
+	for (int i = 0; i < intervals; ++i)
+	{
+		double x0 = kDiodeMin + i * h;
+		double x1 = x0 + h;
+		double y0 = diodeCurve(x0), y1 = diodeCurve(x1);
+		double d0 = h * diodeSlope(x0), d1 = h * diodeSlope(x1);
+		F[i + 1] = F[i] + h * (0.5 * (y0 + y1) + (d0 - d1) / 12.0);
+	}
+	double F0 = F[-kDiodeMin * kDiodeResolution];
+
+	printf("static const _tangentsSaturatorInterval diodeTable[%d] = {\n", intervals);
+	for (int i = 0; i < intervals; ++i)
+	{
+		double x0 = kDiodeMin + i * h;
+		double x1 = x0 + h;
+		double y0 = diodeCurve(x0), y1 = diodeCurve(x1);
+		double d0 = h * diodeSlope(x0), d1 = h * diodeSlope(x1);
+		double c[5] = {
+			y0,
+			d0,
+			3.0 * (y1 - y0) - 2.0 * d0 - d1,
+			2.0 * (y0 - y1) + d0 + d1,
+			F[i] - F0,
+		};
+		printf("\t{ ");
+		for (int j = 0; j < 5; ++j)
+		{
+			printFloat(c[j]);
+			printf(j < 4 ? ", " : " },\n");
+		}
+	}
+	printf("};\n\n");
+}
+
+static void printHalfbands()
+{
+	// FIR: taps and Kaiser beta per stage design
+	double fir47[12], fir19[5], fir11[3];
+	designHalfbandFir(fir47, 12, 7.2);
+	designHalfbandFir(fir19, 5, 8.4);
+	designHalfbandFir(fir11, 3, 6.0);
+
+	printf("// Kaiser-windowed halfband FIRs, odd-offset taps: 47 taps beta 7.2, 19 taps\n");
+	printf("// beta 8.4, 11 taps beta 6.0\n");
+	printArray("halfbandCoeffs47", fir47, 12, 4);
+	printArray("halfbandCoeffs19", fir19, 5, 5);
+	printArray("halfbandCoeffs11", fir11, 3, 3);
+
+	// IIR: sections and transition width per stage design
+	double iir5[5], iir2a[2], iir2b[2];
+	designHalfbandIir(iir5, 5, 0.1);
+	designHalfbandIir(iir2a, 2, 0.3);
+	designHalfbandIir(iir2b, 2, 0.4);
+
+	printf("// Elliptic polyphase IIR halfbands, allpass coefficients alternating between\n");
+	printf("// the branches: 5 sections transition 0.1, 2 sections 0.3, 2 sections 0.4\n");
+	printArray("halfbandIirCoeffs5", iir5, 5, 5);
+	printArray("halfbandIirCoeffs2a", iir2a, 2, 2);
+	printArray("halfbandIirCoeffs2b", iir2b, 2, 2);
+}
+
+int main()
+{
+	printf("/*\n");
+	printf("Constant tables of the Tangents DSP, generated by tools/gentables.cpp\n");
+	printf("(make builds and runs it). Do not edit; change the generator.\n");
+	printf("*/\n\n");
+	printf("#ifndef TANGENTS_TABLES_H\n");
+	printf("#define TANGENTS_TABLES_H\n\n");
+
+	printPrewarp();
+	printExp2();
+	printDiode();
+	printHalfbands();
+
+	printf("#endif // TANGENTS_TABLES_H\n");
+	return 0;
+}
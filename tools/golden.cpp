@@ -0,0 +1,409 @@
+/*
+golden - reference-render corpus and tolerance gate for step()
+
+Renders a fixed set of stimuli (log sine sweep, noise, impulse train, and a
+sawtooth with CV ramps on the cutoff and resonance busses) through every
+Model x Mode x Oversample combination (Auto included) at the default
+settings, and through each other setup of the path (halfband FIR and IIR,
+linear and cubic resamplers, ADAA, Multirate, the table saturator) over a
+subset of them, and either records them as the corpus or compares them
+against it.
+
+The corpus lives in tools/golden/: one raw float32 file per combination
+holding the stimuli back to back, plus manifest.txt with an FNV-1a hash of
+every render and the frames, rate and block size they were made with. A
+compare first checks every reference against the manifest, so a corpus
+file changed other than by -w (or recorded with other settings, or missing
+from it, or a manifest entry left without a file) fails. A render that
+hashes identically is reported as exact; any other render must stay within
+the tolerances (minimum SNR of the difference
+against the reference, and optionally a maximum ULP distance) and contain no
+NaN/Inf. Bit-exactness is not expected across compilers or libm versions, the
+tolerances are the gate.
+
+Usage:
+  golden [-d dir] [-s minSnrDb] [-u maxUlp] [-v]    check against the corpus
+  golden -w [-d dir]                                record a new corpus
+*/
+
+#include "host.h"
+#include "wav.h"
+
+#include <map>
+#include <string>
+#include <unistd.h>
+
+static const int kGoldenSignalFrames = 1024;
+static const int kGoldenBlockFrames = 64;
+static const uint32_t kGoldenSampleRate = 48000;
+
+static const char* const kGoldenManifestHeader = "# combination signal fnv1a64 (%d frames @ %u Hz, %d-frame blocks)";
+
+/**
+ * One stimulus and the parameter settings it is rendered with. Each covers a
+ * different region of the parameter space so the corpus exercises every AGR
+ * zone, resonance from none to near self-oscillation, drive and both CV
+ * busses.
+ */
+struct GoldenSignal
+{
+	const char* name;
+	int cutoff;
+	int resonance;
+	int drive;
+	int agr;
+	bool cv;
+};
+
+static const GoldenSignal goldenSignals[] = {
+	{ "sweep",   1000, 500,   0, 500, false },
+	{ "noise",   2000, 800, 600, 200, false },
+	{ "impulse",  500, 950,   0, 800, false },
+	{ "cvramp",  1000, 300, 300, 500, true },
+};
+
+static const int kGoldenNumSignals = ARRAY_SIZE(goldenSignals);
+
+// Masks of models, modes and oversample settings a variant covers; bit n
+// selects the setting with raw parameter value n
+enum
+{
+	kGoldenModelsAll = (1 << kHostNumModels) - 1,
+	kGoldenModelMS = 1 << 1,
+	kGoldenModesAll = (1 << kNumFilterModes) - 1,
+	kGoldenModesLpBp = (1 << kFilterModeLowpass) | (1 << kFilterModeBandpass),
+	kGoldenModeLp = 1 << kFilterModeLowpass,
+	kGoldenFactorsAll = (1 << kHostNumOversample) - 1,
+	kGoldenAuto = 1 << OVERSAMPLE_AUTO,
+};
+
+/**
+ * One setup of the path the corpus is rendered with: up to two parameters
+ * set on top of the defaults (Hold resampler, exact saturators, no ADAA or
+ * Multirate) and the combinations it covers. Only the defaults run every
+ * combination, the others the ones where they differ, to keep the corpus
+ * small.
+ */
+struct GoldenVariant
+{
+	const char* name;       // file name suffix, empty for the defaults
+	int param[2];           // -1 = unused
+	int value[2];
+	int cutoff;             // Hz for every stimulus, 0 = the stimulus' own
+	int models;
+	int modes;
+	int oversample;
+};
+
+static const GoldenVariant goldenVariants[] = {
+	{ "",           { -1, -1 }, { 0, 0 }, 0, kGoldenModelsAll, kGoldenModesAll, kGoldenFactorsAll | kGoldenAuto },
+	{ "halfband",   { kParamResampler, -1 }, { kResamplerHalfband, 0 }, 0, kGoldenModelsAll, kGoldenModesLpBp, (1 << 1) | (1 << 4) },
+	{ "halfbandiir", { kParamResampler, -1 }, { kResamplerHalfbandIir, 0 }, 0, kGoldenModelsAll, kGoldenModesLpBp, (1 << 1) | (1 << 4) },
+	{ "linear",     { kParamResampler, -1 }, { kResamplerLinear, 0 }, 0, kGoldenModelsAll, kGoldenModesLpBp, (1 << 1) | (1 << 2) },
+	{ "cubic",      { kParamResampler, -1 }, { kResamplerCubic, 0 }, 0, kGoldenModelsAll, kGoldenModesLpBp, (1 << 1) | (1 << 2) },
+	{ "adaa",       { kParamAntialias, -1 }, { 1, 0 }, 0, kGoldenModelsAll, kGoldenModesLpBp, (1 << 0) | (1 << 2) },
+	// Below 375 Hz for the full depth; the CV ramp crosses both thresholds
+	{ "multirate",  { kParamMultirate, -1 }, { 1, 0 }, 250, kGoldenModelsAll, kGoldenModeLp, (1 << 0) | (1 << 1) },
+	{ "table",      { kParamSaturator, -1 }, { 1, 0 }, 0, kGoldenModelMS, kGoldenModesLpBp, (1 << 0) | (1 << 2) },
+	{ "tableadaa",  { kParamSaturator, kParamAntialias }, { 1, 1 }, 0, kGoldenModelMS, kGoldenModesLpBp, 1 << 0 },
+};
+
+static void goldenStimulus(int signal, float* input, float* cvCutoff, float* cvResonance)
+{
+	int n = kGoldenSignalFrames;
+	switch (signal)
+	{
+		case 0:
+			hostSweep(input, n, 20.0f, 20000.0f, 0.5f, (float)kGoldenSampleRate);
+			break;
+		case 1:
+			hostNoise(input, n, 0.5f);
+			break;
+		case 2:
+			for (int i = 0; i < n; ++i)
+				input[i] = (i % 256 == 0) ? 1.0f : 0.0f;
+			break;
+		case 3:
+			for (int i = 0; i < n; ++i)
+				input[i] = 0.5f * (2.0f * (float)(i % 436) / 436.0f - 1.0f);  // ~110 Hz saw
+			hostRamp(cvCutoff, n, -1.0f, 1.0f);
+			hostRamp(cvResonance, n, 0.0f, 1.0f);
+			break;
+	}
+}
+
+/**
+ * Render every stimulus for one combination into out (kGoldenNumSignals
+ * back-to-back signals)
+ */
+static void goldenRender(const GoldenVariant& variant, int model, int mode, int os, float* out)
+{
+	std::vector<float> input(kGoldenSignalFrames), cvCutoff(kGoldenSignalFrames), cvResonance(kGoldenSignalFrames);
+
+	for (int s = 0; s < kGoldenNumSignals; ++s)
+	{
+		const GoldenSignal& sig = goldenSignals[s];
+		goldenStimulus(s, &input[0], &cvCutoff[0], &cvResonance[0]);
+
+		HostPlugin plugin;
+		plugin.create();
+		hostConfigure(plugin, model, mode, os);
+		for (int p = 0; p < 2; ++p)
+		{
+			if (variant.param[p] >= 0)
+				plugin.set(variant.param[p], variant.value[p]);
+		}
+		plugin.set(kParamCutoff, variant.cutoff ? variant.cutoff : sig.cutoff);
+		plugin.set(kParamResonance, sig.resonance);
+		plugin.set(kParamDrive, sig.drive);
+		plugin.set(kParamInputAGR, sig.agr);
+		if (sig.cv)
+		{
+			plugin.set(kParamCvCutoff, 2);
+			plugin.set(kParamCvResonance, 3);
+		}
+
+		plugin.process(&input[0], out + s * kGoldenSignalFrames, kGoldenSignalFrames, kGoldenBlockFrames,
+		               sig.cv ? &cvCutoff[0] : NULL, sig.cv ? &cvResonance[0] : NULL);
+	}
+}
+
+static uint64_t goldenHash(const float* x, int n)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	const uint8_t* p = (const uint8_t*)x;
+	for (size_t i = 0; i < n * sizeof(float); ++i)
+	{
+		h ^= p[i];
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+/**
+ * Distance between two floats in units in the last place
+ */
+static uint32_t goldenUlp(float a, float b)
+{
+	int32_t ia, ib;
+	memcpy(&ia, &a, sizeof(ia));
+	memcpy(&ib, &b, sizeof(ib));
+	if (ia < 0) ia = (int32_t)(0x80000000u - (uint32_t)ia);
+	if (ib < 0) ib = (int32_t)(0x80000000u - (uint32_t)ib);
+	int64_t d = (int64_t)ia - (int64_t)ib;
+	return (uint32_t)(d < 0 ? -d : d);
+}
+
+typedef std::map<std::string, uint64_t> GoldenManifest;
+
+/**
+ * Read the hashes of manifest.txt, keyed "combination signal"; false if it
+ * is missing or was recorded with other frames, rate or block size
+ */
+static bool goldenReadManifest(const char* path, GoldenManifest& manifest)
+{
+	FILE* f = fopen(path, "r");
+	if (!f)
+	{
+		fprintf(stderr, "%s: missing manifest\n", path);
+		return false;
+	}
+
+	char line[256];
+	int frames = 0, blockFrames = 0;
+	unsigned rate = 0;
+	if (!fgets(line, sizeof(line), f) || sscanf(line, kGoldenManifestHeader, &frames, &rate, &blockFrames) != 3 ||
+	    frames != kGoldenSignalFrames || rate != kGoldenSampleRate || blockFrames != kGoldenBlockFrames)
+	{
+		fprintf(stderr, "%s: recorded with other settings than %d frames @ %u Hz, %d-frame blocks\n",
+		        path, kGoldenSignalFrames, kGoldenSampleRate, kGoldenBlockFrames);
+		fclose(f);
+		return false;
+	}
+
+	char name[64], signal[16];
+	unsigned long long hash;
+	while (fgets(line, sizeof(line), f))
+	{
+		if (sscanf(line, "%63s %15s %llx", name, signal, &hash) == 3)
+			manifest[std::string(name) + " " + signal] = hash;
+	}
+	fclose(f);
+	return true;
+}
+
+static void goldenName(char* buf, const GoldenVariant& variant, int model, int mode, int os)
+{
+	sprintf(buf, "%s_%s_%s%s%s", hostModelNames[model], hostModeNames[mode], hostOversampleNames[os],
+	        variant.name[0] ? "_" : "", variant.name);
+}
+
+int main(int argc, char** argv)
+{
+	const char* dir = "tools/golden";
+	bool write = false;
+	bool verbose = false;
+	double minSnr = 60.0;
+	long maxUlp = -1;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "d:s:u:wvh")) != -1)
+	{
+		switch (opt)
+		{
+			case 'd': dir = optarg; break;
+			case 's': minSnr = atof(optarg); break;
+			case 'u': maxUlp = atol(optarg); break;
+			case 'w': write = true; break;
+			case 'v': verbose = true; break;
+			default:
+				fprintf(stderr, "usage: golden [-d dir] [-s minSnrDb] [-u maxUlp] [-v] | golden -w [-d dir]\n");
+				return 1;
+		}
+	}
+
+	NT_globals.sampleRate = kGoldenSampleRate;
+	NT_globals.maxFramesPerStep = kGoldenBlockFrames;
+
+	const int total = kGoldenNumSignals * kGoldenSignalFrames;
+	std::vector<float> out(total), ref;
+	char name[64], path[512];
+
+	FILE* manifest = NULL;
+	GoldenManifest hashes;
+	sprintf(path, "%s/manifest.txt", dir);
+	if (write)
+	{
+		manifest = fopen(path, "w");
+		if (!manifest)
+		{
+			fprintf(stderr, "Can't create %s\n", path);
+			return 1;
+		}
+		fprintf(manifest, kGoldenManifestHeader, kGoldenSignalFrames, kGoldenSampleRate, kGoldenBlockFrames);
+		fprintf(manifest, "\n");
+	}
+	else if (!goldenReadManifest(path, hashes))
+		return 1;
+
+	int exact = 0, within = 0, failed = 0, combinations = 0;
+	double worstSnr = 1e9;
+	uint32_t worstUlp = 0;
+
+	for (size_t v = 0; v < ARRAY_SIZE(goldenVariants); ++v)
+	{
+		const GoldenVariant& variant = goldenVariants[v];
+		for (int model = 0; model < kHostNumModels; ++model)
+		{
+			for (int mode = 0; mode < kNumFilterModes; ++mode)
+			{
+				for (int os = 0; os <= OVERSAMPLE_AUTO; ++os)
+				{
+					if (!(variant.models & (1 << model)) || !(variant.modes & (1 << mode)) || !(variant.oversample & (1 << os)))
+						continue;
+					++combinations;
+					goldenName(name, variant, model, mode, os);
+					sprintf(path, "%s/%s.f32", dir, name);
+					goldenRender(variant, model, mode, os, &out[0]);
+
+					if (write)
+					{
+						if (!wavWrite(path, &out[0], total, kGoldenSampleRate))
+							return 1;
+						for (int s = 0; s < kGoldenNumSignals; ++s)
+							fprintf(manifest, "%s %s %016llx\n", name, goldenSignals[s].name,
+							        (unsigned long long)goldenHash(&out[s * kGoldenSignalFrames], kGoldenSignalFrames));
+						continue;
+					}
+
+					uint32_t unusedRate = 0;
+					if (!wavRead(path, ref, unusedRate) || (int)ref.size() != total)
+					{
+						fprintf(stderr, "%s: missing or wrong-sized reference\n", path);
+						++failed;
+						for (int s = 0; s < kGoldenNumSignals; ++s)
+							hashes.erase(std::string(name) + " " + goldenSignals[s].name);
+						continue;
+					}
+
+					for (int s = 0; s < kGoldenNumSignals; ++s)
+					{
+						const float* a = &ref[s * kGoldenSignalFrames];
+						const float* b = &out[s * kGoldenSignalFrames];
+
+						// The reference must be the render the manifest recorded
+						GoldenManifest::iterator entry = hashes.find(std::string(name) + " " + goldenSignals[s].name);
+						uint64_t refHash = goldenHash(a, kGoldenSignalFrames);
+						if (entry == hashes.end() || entry->second != refHash)
+						{
+							printf("%-24s %-8s FAIL  reference %s the manifest\n", name, goldenSignals[s].name,
+							       entry == hashes.end() ? "missing from" : "does not match");
+							++failed;
+							if (entry != hashes.end())
+								hashes.erase(entry);
+							continue;
+						}
+						hashes.erase(entry);
+
+						if (refHash == goldenHash(b, kGoldenSignalFrames))
+						{
+							++exact;
+							if (verbose)
+								printf("%-24s %-8s exact\n", name, goldenSignals[s].name);
+							continue;
+						}
+
+						double signal = 0.0, noise = 0.0;
+						uint32_t ulp = 0;
+						bool finite = true;
+						for (int i = 0; i < kGoldenSignalFrames; ++i)
+						{
+							if (!(b[i] == b[i]) || b[i] > 1e30f || b[i] < -1e30f)
+								finite = false;
+							double d = (double)b[i] - a[i];
+							signal += (double)a[i] * a[i];
+							noise += d * d;
+							uint32_t u = goldenUlp(a[i], b[i]);
+							if (u > ulp) ulp = u;
+						}
+						double snr = (noise > 0.0) ? 10.0 * log10((signal > 0.0 ? signal : 1e-30) / noise) : 1e9;
+
+						bool ok = finite && snr >= minSnr && (maxUlp < 0 || (long)ulp <= maxUlp);
+						if (snr < worstSnr) worstSnr = snr;
+						if (ulp > worstUlp) worstUlp = ulp;
+
+						if (ok)
+							++within;
+						else
+							++failed;
+
+						if (!ok || verbose)
+							printf("%-24s %-8s %s  SNR %7.1f dB  max %u ulp%s\n", name, goldenSignals[s].name,
+							       ok ? "ok  " : "FAIL", snr, ulp, finite ? "" : "  NaN/Inf");
+					}
+				}
+			}
+		}
+	}
+
+	if (write)
+	{
+		fclose(manifest);
+		printf("Recorded %d combinations x %d signals in %s\n", combinations, kGoldenNumSignals, dir);
+		return 0;
+	}
+
+	// Whatever the corpus did not consume is a render it no longer has
+	for (GoldenManifest::iterator it = hashes.begin(); it != hashes.end(); ++it)
+	{
+		printf("%-33s FAIL  in the manifest, not in the corpus\n", it->first.c_str());
+		++failed;
+	}
+
+	printf("%d exact, %d within tolerance, %d failed", exact, within, failed);
+	if (worstSnr < 1e9)
+		printf("  (worst SNR %.1f dB, worst %u ulp)", worstSnr, worstUlp);
+	printf("\n");
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,241 @@
+/*
+Tangents host harness
+
+Compiles tangents.cpp straight into a host tool (one translation unit per
+tool) against the stub API in tools/stub, and provides a minimal disting NT
+"host": memory allocation through the factory, the v[] parameter array, bus
+layout and block-by-block stepping. The tools built on top of it never call
+the DSP helpers through anything but the plugin's own factory, except where a
+tool deliberately benchmarks a helper in isolation.
+*/
+
+#ifndef TANGENTS_HOST_H
+#define TANGENTS_HOST_H
+
+#include "../tangents.cpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+// ============================================================================
+// STUB API IMPLEMENTATION
+// ============================================================================
+
+static const int kHostNumBusses = 28;
+static const int kHostDefaultSampleRate = 48000;
+static const int kHostDefaultBlockFrames = 128;
+
+_NT_globals NT_globals = { kHostDefaultSampleRate, kHostDefaultBlockFrames, NULL, 0 };
+
+void NT_drawText(int, int, const char*, int, _NT_textAlignment, _NT_textSize) {}
+void NT_drawShapeI(_NT_shape, int, int, int, int, int) {}
+void NT_drawShapeF(_NT_shape, float, float, float, float, float) {}
+
+int NT_intToString(char* buffer, int32_t value)
+{
+	return sprintf(buffer, "%d", (int)value);
+}
+
+int NT_floatToString(char* buffer, float value, int decimalPlaces)
+{
+	return sprintf(buffer, "%.*f", decimalPlaces, value);
+}
+
+uint32_t NT_algorithmIndex(const _NT_algorithm*) { return 0; }
+uint32_t NT_parameterOffset(void) { return 0; }
+void NT_setParameterFromUi(uint32_t, uint32_t, int16_t) {}
+void NT_setParameterFromAudio(uint32_t, uint32_t, int16_t) {}
+
+// ============================================================================
+// TIMING
+// ============================================================================
+
+/**
+ * Monotonic wall clock in seconds
+ */
+inline double hostSeconds()
+{
+	typedef std::chrono::steady_clock clock;
+	return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+// ============================================================================
+// PLUGIN INSTANCE
+// ============================================================================
+
+/**
+ * One Tangents instance plus the bus memory it is stepped against.
+ *
+ * Busses are laid out the way the NT does it: bus N (1-based) occupies
+ * numFrames consecutive floats starting at (N - 1) * numFrames, where
+ * numFrames is the size of the block being stepped.
+ */
+struct HostPlugin
+{
+	const _NT_factory* factory;
+	_NT_algorithmRequirements req;
+	std::vector<uint64_t> sram, dram, dtc, itc;
+	std::vector<int16_t> v;
+	std::vector<float> busses;
+	_NT_algorithm* alg;
+
+	HostPlugin() : factory(NULL), alg(NULL) {}
+
+	/**
+	 * Instantiate through the factory exactly as the module does, then load
+	 * every parameter with its default value
+	 */
+	void create(const int32_t* specifications = NULL)
+	{
+		factory = (const _NT_factory*)pluginEntry(kNT_selector_factoryInfo, 0);
+
+		memset(&req, 0, sizeof(req));
+		factory->calculateRequirements(req, specifications);
+
+		sram.assign(req.sram / 8 + 1, 0);
+		dram.assign(req.dram / 8 + 1, 0);
+		dtc.assign(req.dtc / 8 + 1, 0);
+		itc.assign(req.itc / 8 + 1, 0);
+
+		_NT_algorithmMemoryPtrs ptrs;
+		ptrs.sram = (uint8_t*)&sram[0];
+		ptrs.dram = (uint8_t*)&dram[0];
+		ptrs.dtc = (uint8_t*)&dtc[0];
+		ptrs.itc = (uint8_t*)&itc[0];
+
+		alg = factory->construct(ptrs, req, specifications);
+
+		v.assign(req.numParameters, 0);
+		for (uint32_t p = 0; p < req.numParameters; ++p)
+			v[p] = alg->parameters[p].def;
+		alg->v = &v[0];
+		alg->vIncludingCommon = &v[0];
+
+		for (uint32_t p = 0; p < req.numParameters; ++p)
+			factory->parameterChanged(alg, p);
+
+		busses.assign(kHostNumBusses * NT_globals.maxFramesPerStep, 0.0f);
+	}
+
+	/**
+	 * Set a parameter to a raw value and notify the algorithm
+	 */
+	void set(int p, int value)
+	{
+		v[p] = (int16_t)value;
+		factory->parameterChanged(alg, p);
+	}
+
+	/**
+	 * Pointer to bus n (1-based) for a block of numFrames
+	 */
+	float* bus(int n, int numFrames)
+	{
+		return &busses[(n - 1) * numFrames];
+	}
+
+	/**
+	 * Step one block; numFrames must be a multiple of 4 and no larger than
+	 * NT_globals.maxFramesPerStep
+	 */
+	void step(int numFrames)
+	{
+		factory->step(alg, &busses[0], numFrames / 4);
+	}
+
+	/**
+	 * Run a mono signal from the input bus to the output bus block by block,
+	 * optionally with CV signals on the busses selected by the CV parameters.
+	 * Any tail shorter than a multiple of 4 frames is left untouched.
+	 */
+	void process(const float* input, float* output, int length, int blockFrames,
+	             const float* cvCutoff = NULL, const float* cvResonance = NULL)
+	{
+		int inBus = v[kParamInput];
+		int outBus = v[kParamOutput];
+		int cvCutoffBus = v[kParamCvCutoff];
+		int cvResonanceBus = v[kParamCvResonance];
+
+		for (int pos = 0; pos + 4 <= length; pos += blockFrames)
+		{
+			int n = length - pos;
+			if (n > blockFrames) n = blockFrames;
+			n &= ~3;
+
+			memcpy(bus(inBus, n), input + pos, n * sizeof(float));
+			if (cvCutoff && cvCutoffBus > 0)
+				memcpy(bus(cvCutoffBus, n), cvCutoff + pos, n * sizeof(float));
+			if (cvResonance && cvResonanceBus > 0)
+				memcpy(bus(cvResonanceBus, n), cvResonance + pos, n * sizeof(float));
+			step(n);
+			memcpy(output + pos, bus(outBus, n), n * sizeof(float));
+		}
+	}
+};
+
+// ============================================================================
+// PARAMETER SPACE
+// ============================================================================
+
+static const int kHostNumModels = 3;
+static const int kHostNumOversample = 5;      // fixed factors; Auto follows them
+
+static const char* const hostModelNames[] = { "YU", "MS", "XX" };
+static const char* const hostModeNames[] = { "LP", "BP", "HP", "AP" };
+static const char* const hostOversampleNames[] = { "1x", "2x", "4x", "8x", "16x", "Auto" };
+
+/**
+ * Route input bus 1 to an output bus in replace mode and pick the filter
+ * configuration
+ */
+inline void hostConfigure(HostPlugin& plugin, int model, int mode, int oversample)
+{
+	plugin.set(kParamInput, 1);
+	plugin.set(kParamOutputMode, 1);
+	plugin.set(kParamModel, model);
+	plugin.set(kParamMode, mode);
+	plugin.set(kParamOversample, oversample);
+}
+
+// ============================================================================
+// TEST SIGNALS
+// ============================================================================
+
+/**
+ * Deterministic white noise in [-amplitude, amplitude]
+ */
+inline void hostNoise(float* dst, int length, float amplitude, uint32_t seed = 0x2545F491)
+{
+	uint32_t state = seed ? seed : 1;
+	for (int i = 0; i < length; ++i)
+		dst[i] = amplitude * (2.0f * fastRandom(state) - 1.0f);
+}
+
+/**
+ * Exponential (log-frequency) sine sweep from f0 to f1 Hz over length samples
+ */
+inline void hostSweep(float* dst, int length, float f0, float f1, float amplitude, float sampleRate)
+{
+	double ratio = log((double)f1 / f0);
+	double span = (double)length / sampleRate;
+	for (int i = 0; i < length; ++i)
+	{
+		double t = (double)i / sampleRate;
+		double phase = 2.0 * M_PI * f0 * span / ratio * (exp(t / span * ratio) - 1.0);
+		dst[i] = amplitude * (float)sin(phase);
+	}
+}
+
+/**
+ * Linear ramp from a to b over length samples
+ */
+inline void hostRamp(float* dst, int length, float a, float b)
+{
+	for (int i = 0; i < length; ++i)
+		dst[i] = a + (b - a) * (float)i / (float)(length > 1 ? length - 1 : 1);
+}
+
+#endif // TANGENTS_HOST_H
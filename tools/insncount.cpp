@@ -0,0 +1,89 @@
+/*
+insncount - fixed workload for instruction counting under qemu-arm
+
+Built as a static ARM Linux executable for the A-profile proxy of the
+hardware codegen (ARMv8-A Thumb-2 with its FP unit at -Os, which has the
+FPv5 instructions of the M7) and run under qemu-arm with the TCG instruction
+counting plugin by tools/insncount.sh. qemu-arm cannot run the M-profile
+code itself. It only renders: one configuration,
+a fixed number of frames of noise, no timing and no output. The difference
+between two runs of N and 2N frames still holds the per-frame work of the
+harness (generating the noise, copying blocks to and from the busses,
+summing the output); -s runs the same harness without calling step(), and
+insncount.sh takes that run's difference off, which leaves N frames of
+step() (startup, construct() and warm-up cancel out).
+
+Host timings say little about the M7, whose scalar single-precision FPU and
+lack of SIMD make the relative cost of the saturators, divides and libm calls
+quite different; instruction counts of Thumb-2 and VFP code of the same
+shape are a usable proxy when no hardware is attached. They ignore pipeline
+stalls, flash/ITC wait states and the cost differences between
+instructions.
+
+Usage:
+  insncount [-m model] [-M mode] [-x oversample] [-n frames] [-b blockFrames] [-d drive] [-s]
+*/
+
+#include "host.h"
+
+#include <unistd.h>
+
+int main(int argc, char** argv)
+{
+	int model = 0;
+	int mode = kFilterModeLowpass;
+	int oversample = 0;
+	int frames = 4096;
+	int blockFrames = kHostDefaultBlockFrames;
+	int drive = 500;
+	bool skipStep = false;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "m:M:x:n:b:d:sh")) != -1)
+	{
+		switch (opt)
+		{
+			case 'm': model = atoi(optarg); break;
+			case 'M': mode = atoi(optarg); break;
+			case 'x': oversample = atoi(optarg); break;
+			case 'n': frames = atoi(optarg); break;
+			case 'b': blockFrames = atoi(optarg); break;
+			case 'd': drive = atoi(optarg); break;
+			case 's': skipStep = true; break;
+			default:
+				fprintf(stderr, "usage: insncount [-m model] [-M mode] [-x oversample] [-n frames] [-b blockFrames] [-d drive] [-s]\n");
+				return 1;
+		}
+	}
+
+	frames &= ~3;
+	blockFrames &= ~3;
+	if (frames <= 0 || blockFrames <= 0)
+		return 1;
+
+	std::vector<float> input(frames), output(frames);
+	hostNoise(&input[0], frames, 0.5f);
+
+	HostPlugin plugin;
+	plugin.create();
+	hostConfigure(plugin, model, mode, oversample);
+	plugin.set(kParamDrive, drive);
+
+	// HostPlugin::process, with step() left out of the -s run
+	int inBus = plugin.v[kParamInput];
+	int outBus = plugin.v[kParamOutput];
+	for (int pos = 0; pos < frames; pos += blockFrames)
+	{
+		int n = (frames - pos < blockFrames) ? frames - pos : blockFrames;
+		memcpy(plugin.bus(inBus, n), &input[pos], n * sizeof(float));
+		if (!skipStep)
+			plugin.step(n);
+		memcpy(&output[pos], plugin.bus(outBus, n), n * sizeof(float));
+	}
+
+	// Keep the render observable so it cannot be optimised away
+	float sum = 0.0f;
+	for (int i = 0; i < frames; ++i)
+		sum += output[i];
+	return sum != sum ? 2 : 0;
+}
@@ -0,0 +1,76 @@
+#!/bin/sh
+#
+# Instructions per sample of step() under qemu-arm, on the A-profile proxy of
+# the Cortex-M7 codegen (ARMv8-A Thumb-2 and FP at -Os, see ARM_PROXY_FLAGS in
+# the Makefile). The counts are a proxy: the M7's own FPv5-D16 M-profile code
+# cannot run under qemu-arm.
+#
+# Runs the insncount executable (see tools/insncount.cpp) for every model and
+# oversample factor with N and 2N frames under qemu-arm with the TCG
+# instruction counting plugin (libinsn.so from qemu's contrib/plugins), and
+# the same pair with -s (the harness without step()), and reports
+# ((count(2N) - count(N)) - (harness(2N) - harness(N))) / N.
+#
+# Usage:
+#   tools/insncount.sh <insncount executable> [frames] [mode]
+#
+# Environment:
+#   QEMU_ARM         qemu-arm binary (default: qemu-arm)
+#   QEMU_PLUGIN      path to libinsn.so (default: $QEMU_PLUGIN_DIR/libinsn.so)
+#   QEMU_CPU         emulated CPU, needs the ARMv8-A FP instructions (VSEL,
+#                    VMAXNM, VRINT) of the proxy build (default: max)
+
+set -e
+
+EXE=$1
+FRAMES=${2:-4096}
+MODE=${3:-0}
+QEMU_ARM=${QEMU_ARM:-qemu-arm}
+QEMU_CPU=${QEMU_CPU:-max}
+QEMU_PLUGIN=${QEMU_PLUGIN:-${QEMU_PLUGIN_DIR:-/usr/lib/qemu/plugins}/libinsn.so}
+
+if [ -z "$EXE" ] || [ ! -x "$EXE" ]; then
+	echo "usage: $0 <insncount executable> [frames] [mode]" >&2
+	exit 1
+fi
+if [ ! -f "$QEMU_PLUGIN" ]; then
+	echo "$QEMU_PLUGIN not found; set QEMU_PLUGIN or QEMU_PLUGIN_DIR" >&2
+	exit 1
+fi
+
+# Total guest instructions of one run ("insns: N" / "total insns: N")
+count() {
+	"$QEMU_ARM" -cpu "$QEMU_CPU" -plugin "$QEMU_PLUGIN" -d plugin "$EXE" "$@" 2>&1 >/dev/null \
+		| sed -n 's/.*insns: *\([0-9][0-9]*\).*/\1/p' | tail -n 1
+}
+
+MODELS="YU MS XX"
+FACTORS="1x 2x 4x 8x 16x"
+
+echo "Instructions per sample, mode $MODE, $FRAMES frames (ARMv8-A proxy of the M7, qemu-arm -cpu $QEMU_CPU)"
+echo ""
+printf "%-6s" "Model"
+for f in $FACTORS; do printf "%10s" "$f"; done
+echo ""
+
+m=0
+for model in $MODELS; do
+	printf "%-6s" "$model"
+	x=0
+	for f in $FACTORS; do
+		a=$(count -m $m -M "$MODE" -x $x -n "$FRAMES")
+		b=$(count -m $m -M "$MODE" -x $x -n $((FRAMES * 2)))
+		a0=$(count -m $m -M "$MODE" -x $x -n "$FRAMES" -s)
+		b0=$(count -m $m -M "$MODE" -x $x -n $((FRAMES * 2)) -s)
+		if [ -z "$a" ] || [ -z "$b" ] || [ -z "$a0" ] || [ -z "$b0" ]; then
+			echo "" >&2
+			echo "no instruction count from $QEMU_ARM; is $QEMU_PLUGIN the insn plugin?" >&2
+			exit 1
+		fi
+		awk -v a="$a" -v b="$b" -v a0="$a0" -v b0="$b0" -v n="$FRAMES" \
+			'BEGIN { printf "%10.1f", ((b - a) - (b0 - a0)) / n }'
+		x=$((x + 1))
+	done
+	echo ""
+	m=$((m + 1))
+done
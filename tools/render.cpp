@@ -0,0 +1,168 @@
+/*
+render - offline renderer and throughput meter for Tangents
+
+Pushes a WAV / raw float32 file (or generated noise) through construct() and
+step() block by block and reports samples/sec and the realtime factor for
+every Model x Mode x Oversample combination, or for the subset selected on
+the command line. With exactly one combination selected the rendered audio
+can be written out with -o.
+
+Usage:
+  render [-i in.wav|in.f32] [-o out.wav|out.f32] [-r rate] [-d seconds]
+         [-b blockFrames] [-n passes] [-m model] [-M mode] [-x oversample]
+         [-p param=value ...] [-S spec,spec[,spec]]
+
+  -m/-M/-x take the raw parameter value (model 0-2, mode 0-3, oversample 0-4,
+  5 = Auto).
+  -p sets any parameter by index to a raw value before rendering.
+  -S instantiates with the given specifications (Max oversample 0-4,
+  Halfbands 0-2, Multirate 0-2, default 2 if left out) instead of the
+  defaults; the memory they take is printed.
+*/
+
+#include "host.h"
+#include "wav.h"
+
+#include <unistd.h>
+
+static void usage()
+{
+	fprintf(stderr,
+		"usage: render [-i input] [-o output] [-r rate] [-d seconds] [-b blockFrames]\n"
+		"              [-n passes] [-m model] [-M mode] [-x oversample] [-p param=value]\n"
+		"              [-S spec,spec[,spec]]\n");
+	exit(1);
+}
+
+int main(int argc, char** argv)
+{
+	const char* inputPath = NULL;
+	const char* outputPath = NULL;
+	uint32_t sampleRate = kHostDefaultSampleRate;
+	float seconds = 1.0f;
+	int blockFrames = kHostDefaultBlockFrames;
+	int passes = 1;
+	int onlyModel = -1, onlyMode = -1, onlyOversample = -1;
+	std::vector<int> overrideParam, overrideValue;
+	int32_t specs[kNumSpecifications];
+	const int32_t* specValues = NULL;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "i:o:r:d:b:n:m:M:x:p:S:h")) != -1)
+	{
+		switch (opt)
+		{
+			case 'i': inputPath = optarg; break;
+			case 'o': outputPath = optarg; break;
+			case 'r': sampleRate = (uint32_t)atoi(optarg); break;
+			case 'd': seconds = (float)atof(optarg); break;
+			case 'b': blockFrames = atoi(optarg); break;
+			case 'n': passes = atoi(optarg); break;
+			case 'm': onlyModel = atoi(optarg); break;
+			case 'M': onlyMode = atoi(optarg); break;
+			case 'x': onlyOversample = atoi(optarg); break;
+			case 'p':
+			{
+				int p, value;
+				if (sscanf(optarg, "%d=%d", &p, &value) != 2 || p < 0 || p >= kNumParameters)
+					usage();
+				overrideParam.push_back(p);
+				overrideValue.push_back(value);
+				break;
+			}
+			case 'S':
+			{
+				specs[kSpecMultirate] = specifications[kSpecMultirate].def;
+				if (sscanf(optarg, "%d,%d,%d", &specs[kSpecMaxOversample], &specs[kSpecHalfbands], &specs[kSpecMultirate]) < 2)
+					usage();
+				specValues = specs;
+				break;
+			}
+			default: usage();
+		}
+	}
+
+	if (blockFrames < 4 || (blockFrames & 3) || passes < 1)
+		usage();
+
+	std::vector<float> input;
+	if (inputPath)
+	{
+		if (!wavRead(inputPath, input, sampleRate))
+			return 1;
+	}
+	else
+	{
+		input.resize((size_t)(seconds * sampleRate));
+		hostNoise(&input[0], (int)input.size(), 0.5f);
+	}
+	if (input.size() < 4)
+	{
+		fprintf(stderr, "Input is too short\n");
+		return 1;
+	}
+
+	NT_globals.sampleRate = sampleRate;
+	NT_globals.maxFramesPerStep = blockFrames;
+
+	std::vector<float> output(input.size(), 0.0f);
+	int length = (int)input.size();
+	int combinations = 0;
+
+	printf("%d samples @ %u Hz, %d-frame blocks, %d pass(es)\n", length, sampleRate, blockFrames, passes);
+	_NT_algorithmRequirements req;
+	calculateRequirements(req, specValues);
+	printf("Memory: SRAM %u, DTC %u, DRAM %u bytes\n\n", req.sram, req.dtc, req.dram);
+	printf("Model  Mode  OS       samples/s   x realtime\n");
+
+	for (int model = 0; model < kHostNumModels; ++model)
+	{
+		if (onlyModel >= 0 && model != onlyModel) continue;
+		for (int mode = 0; mode < kNumFilterModes; ++mode)
+		{
+			if (onlyMode >= 0 && mode != onlyMode) continue;
+			for (int os = 0; os <= kHostNumOversample; ++os)    // last is Auto
+			{
+				if (onlyOversample >= 0 && os != onlyOversample) continue;
+
+				// Untimed warm-up on a throwaway instance so the first combination
+				// isn't charged for cold caches
+				HostPlugin plugin;
+				for (int run = 0; run < 2; ++run)
+				{
+					plugin.create(specValues);
+					hostConfigure(plugin, model, mode, os);
+					for (size_t j = 0; j < overrideParam.size(); ++j)
+						plugin.set(overrideParam[j], overrideValue[j]);
+					if (run == 0)
+						plugin.process(&input[0], &output[0], length < 4096 ? length : 4096, blockFrames);
+				}
+
+				double start = hostSeconds();
+				for (int pass = 0; pass < passes; ++pass)
+					plugin.process(&input[0], &output[0], length, blockFrames);
+				double elapsed = hostSeconds() - start;
+
+				double rate = (double)length * passes / elapsed;
+				printf("%-5s  %-4s  %-4s  %12.0f  %11.1f\n",
+					hostModelNames[model], hostModeNames[mode], hostOversampleNames[os],
+					rate, rate / sampleRate);
+				++combinations;
+			}
+		}
+	}
+
+	if (outputPath)
+	{
+		if (combinations != 1)
+		{
+			fprintf(stderr, "-o needs exactly one Model/Mode/Oversample combination (use -m -M -x)\n");
+			return 1;
+		}
+		if (!wavWrite(outputPath, &output[0], output.size(), sampleRate))
+			return 1;
+		printf("\nWrote %s\n", outputPath);
+	}
+
+	return 0;
+}
@@ -0,0 +1,302 @@
+/*
+response - measured frequency response of step() vs the draw() curve
+
+Measures the magnitude and phase response of the filter with a stepped
+log-frequency sine (48 points, 20 Hz - 20 kHz) at a level low enough to keep
+the saturators in their linear region, for every mode and a set of
+resonance settings, and compares it with:
+
+  analytic  The exact small-signal response of the filter as implemented
+            (hold input across the oversampled substeps, average the
+            output), built from coefficients computed here from the
+            documented formulas (g = tan(pi fc / fs_os), k = 2 - 1.9 res)
+            rather than by calling calculateFilterCoeffs(). Any deviation
+            means the DSP or the coefficient calculation changed.
+
+  display   displayResponse(), the approximate curve draw() renders,
+            compared against the measured response with the saturators'
+            small-signal gain divided out.
+
+Exits non-zero if measured and analytic differ by more than the tolerance
+anywhere the analytic response is above -60 dB.
+
+Usage:
+  response [-m model] [-x oversample] [-f cutoff] [-l level] [-t toleranceDb] [-v] [-c out.csv]
+*/
+
+#include "host.h"
+
+#include <unistd.h>
+#include <complex>
+
+typedef std::complex<double> cdouble;
+
+static const int kNumPoints = 48;
+static const int resonances[] = { 0, 250, 500, 750, 950 };
+static const int kNumResonances = ARRAY_SIZE(resonances);
+
+// ============================================================================
+// ANALYTIC MODEL
+// ============================================================================
+
+/**
+ * Base-rate state-space model of `oversample` SVF substeps with the input
+ * held and the mode output averaged: s' = A s + B u, y = C s + D u
+ */
+struct SvfModel
+{
+	double A[2][2], B[2], C[2], D;
+
+	void build(double g, double k, int mode, int oversample)
+	{
+		double gInv = 1.0 / (1.0 + g * (g + k));
+
+		// One substep, states s = (bp, lp)
+		double hpS[2] = { -k * gInv, -gInv }, hpU = gInv;
+		double bpS[2] = { 1.0 + g * hpS[0], g * hpS[1] }, bpU = g * hpU;
+		double lpS[2] = { g * bpS[0], 1.0 + g * bpS[1] }, lpU = g * bpU;
+
+		double a[2][2] = { { bpS[0], bpS[1] }, { lpS[0], lpS[1] } };
+		double b[2] = { bpU, lpU };
+		double c[2], d;
+		switch (mode)
+		{
+			case kFilterModeBandpass: c[0] = bpS[0]; c[1] = bpS[1]; d = bpU; break;
+			case kFilterModeHighpass: c[0] = hpS[0]; c[1] = hpS[1]; d = hpU; break;
+			case kFilterModeAllpass:  c[0] = lpS[0] - hpS[0]; c[1] = lpS[1] - hpS[1]; d = lpU - hpU; break;
+			default:                  c[0] = lpS[0]; c[1] = lpS[1]; d = lpU;
+		}
+
+		// Compose: s_j = M s + v u, accumulate y over the substeps
+		double M[2][2] = { { 1, 0 }, { 0, 1 } }, v[2] = { 0, 0 };
+		double cAcc[2] = { 0, 0 }, dAcc = 0;
+		for (int j = 0; j < oversample; ++j)
+		{
+			cAcc[0] += c[0] * M[0][0] + c[1] * M[1][0];
+			cAcc[1] += c[0] * M[0][1] + c[1] * M[1][1];
+			dAcc += c[0] * v[0] + c[1] * v[1] + d;
+
+			double m[2][2], w[2];
+			for (int r = 0; r < 2; ++r)
+			{
+				m[r][0] = a[r][0] * M[0][0] + a[r][1] * M[1][0];
+				m[r][1] = a[r][0] * M[0][1] + a[r][1] * M[1][1];
+				w[r] = a[r][0] * v[0] + a[r][1] * v[1] + b[r];
+			}
+			memcpy(M, m, sizeof(M));
+			memcpy(v, w, sizeof(v));
+		}
+
+		memcpy(A, M, sizeof(A));
+		memcpy(B, v, sizeof(B));
+		C[0] = cAcc[0] / oversample;
+		C[1] = cAcc[1] / oversample;
+		D = dAcc / oversample;
+	}
+
+	/**
+	 * H(e^jw) = C (zI - A)^-1 B + D
+	 */
+	cdouble response(double w) const
+	{
+		cdouble z = std::polar(1.0, w);
+		cdouble m00 = z - A[0][0], m01 = -A[0][1], m10 = -A[1][0], m11 = z - A[1][1];
+		cdouble det = m00 * m11 - m01 * m10;
+		cdouble x0 = (m11 * B[0] - m01 * B[1]) / det;
+		cdouble x1 = (-m10 * B[0] + m00 * B[1]) / det;
+		return C[0] * x0 + C[1] * x1 + D;
+	}
+};
+
+/**
+ * Small-signal gain of the input and output saturators for a model, as step()
+ * applies them (slope at zero of the saturator times its pre-gain)
+ */
+static double saturatorGain(int model, double k)
+{
+	float resAmt = (float)((2.0 - k) / 1.9);
+	const float h = 1e-4f;
+	float inGain, outGain;
+	switch (model)
+	{
+		case 1:
+			inGain = (1.0f + resAmt * 0.5f) * (diodeClip(h) - diodeClip(-h)) / (2.0f * h);
+			outGain = (diodeClip(h) - diodeClip(-h)) / (2.0f * h);
+			break;
+		case 2:
+			inGain = (1.0f + resAmt * 2.0f) * (aggressiveSat(h) - aggressiveSat(-h)) / (2.0f * h);
+			outGain = (aggressiveSat(h) - aggressiveSat(-h)) / (2.0f * h);
+			break;
+		default:
+			inGain = (1.0f + resAmt) * (fastTanh(h) - fastTanh(-h)) / (2.0f * h);
+			outGain = (fastTanh(h) - fastTanh(-h)) / (2.0f * h);
+	}
+	return (double)inGain * outGain;
+}
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+/**
+ * Complex gain of the plugin at f Hz: sine in, single-bin correlation of
+ * input and output over a whole number of periods after a settling segment
+ */
+static cdouble measure(HostPlugin& plugin, double f, double rate, float level, std::vector<float>& in, std::vector<float>& out)
+{
+	int period = (int)(rate / f) + 1;
+	int settle = period * 3 > 4096 ? period * 3 : 4096;
+	int cycles = (int)ceil(8192.0 * f / rate);
+	int window = (int)floor(cycles * rate / f + 0.5);
+	int total = (settle + window + 3) & ~3;
+
+	in.resize(total);
+	out.resize(total);
+	double w = 2.0 * M_PI * f / rate;
+	for (int i = 0; i < total; ++i)
+		in[i] = level * (float)sin(w * i);
+
+	plugin.process(&in[0], &out[0], total, kHostDefaultBlockFrames);
+
+	cdouble x = 0.0, y = 0.0;
+	for (int i = settle; i < settle + window; ++i)
+	{
+		cdouble e = std::polar(1.0, -w * i);
+		x += (double)in[i] * e;
+		y += (double)out[i] * e;
+	}
+	return y / x;
+}
+
+static double toDb(double magnitude)
+{
+	return 20.0 * log10(magnitude > 1e-15 ? magnitude : 1e-15);
+}
+
+static double wrapDegrees(double d)
+{
+	while (d > 180.0) d -= 360.0;
+	while (d < -180.0) d += 360.0;
+	return d;
+}
+
+int main(int argc, char** argv)
+{
+	int model = 0;
+	int oversample = 1;
+	int cutoff = 1000;
+	float level = 0.001f;
+	double tolerance = 0.5;
+	bool verbose = false;
+	const char* csvPath = NULL;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "m:x:f:l:t:vc:h")) != -1)
+	{
+		switch (opt)
+		{
+			case 'm': model = atoi(optarg); break;
+			case 'x': oversample = atoi(optarg); break;
+			case 'f': cutoff = atoi(optarg); break;
+			case 'l': level = (float)atof(optarg); break;
+			case 't': tolerance = atof(optarg); break;
+			case 'v': verbose = true; break;
+			case 'c': csvPath = optarg; break;
+			default:
+				fprintf(stderr, "usage: response [-m model] [-x oversample] [-f cutoff] [-l level] [-t toleranceDb] [-v] [-c out.csv]\n");
+				return 1;
+		}
+	}
+
+	FILE* csv = NULL;
+	if (csvPath)
+	{
+		csv = fopen(csvPath, "w");
+		if (!csv)
+		{
+			fprintf(stderr, "Can't create %s\n", csvPath);
+			return 1;
+		}
+		fprintf(csv, "mode,resonance,freq_hz,measured_db,measured_deg,analytic_db,analytic_deg,display_db\n");
+	}
+
+	const double rate = NT_globals.sampleRate;
+	const int factor = 1 << oversample;
+	std::vector<float> in, out, silence(512 * kHostDefaultBlockFrames, 0.0f), scratch(silence.size());
+	int failures = 0;
+
+	printf("Model %s, %s, cutoff %d Hz, level %.3f\n\n", hostModelNames[model], hostOversampleNames[oversample], cutoff, level);
+	printf("Mode  Res%%   max |meas-analytic|   max phase err   max |meas-display|   rms |meas-display|\n");
+
+	for (int mode = 0; mode < kNumFilterModes; ++mode)
+	{
+		for (int r = 0; r < kNumResonances; ++r)
+		{
+			HostPlugin plugin;
+			plugin.create();
+			hostConfigure(plugin, model, mode, oversample);
+			plugin.set(kParamCutoff, cutoff);
+			plugin.set(kParamResonance, resonances[r]);
+
+			// Let the parameter smoothing converge
+			plugin.process(&silence[0], &scratch[0], (int)silence.size(), kHostDefaultBlockFrames);
+
+			double g = tan(M_PI * cutoff / (rate * factor));
+			double k = 2.0 - (resonances[r] / 1000.0) * 1.9;
+			SvfModel svf;
+			svf.build(g, k, mode, factor);
+			double gain = saturatorGain(model, k);
+
+			double maxErr = 0.0, maxPhase = 0.0, maxDisp = 0.0, sumDisp = 0.0;
+			for (int i = 0; i < kNumPoints; ++i)
+			{
+				double f = 20.0 * pow(1000.0, (double)i / (kNumPoints - 1));
+				cdouble measured = measure(plugin, f, rate, level, in, out);
+				cdouble analytic = gain * svf.response(2.0 * M_PI * f / rate);
+				double display = displayResponse((FilterMode)mode, (float)(f / cutoff), resonances[r] / 10.0f);
+
+				double measDb = toDb(std::abs(measured));
+				double anaDb = toDb(std::abs(analytic));
+				double dispDb = toDb(display);
+				double measDeg = std::arg(measured) * 180.0 / M_PI;
+				double anaDeg = std::arg(analytic) * 180.0 / M_PI;
+				double svfDb = measDb - toDb(gain);
+
+				if (anaDb > -60.0)
+				{
+					double err = fabs(measDb - anaDb);
+					double phaseErr = fabs(wrapDegrees(measDeg - anaDeg));
+					if (err > maxErr) maxErr = err;
+					if (phaseErr > maxPhase) maxPhase = phaseErr;
+				}
+				double dispErr = fabs(svfDb - dispDb);
+				if (dispErr > maxDisp) maxDisp = dispErr;
+				sumDisp += dispErr * dispErr;
+
+				if (verbose)
+					printf("      %8.1f Hz  measured %7.2f dB %7.1f deg  analytic %7.2f dB %7.1f deg  display %7.2f dB\n",
+						f, measDb, measDeg, anaDb, anaDeg, dispDb + toDb(gain));
+				if (csv)
+					fprintf(csv, "%s,%d,%.2f,%.3f,%.2f,%.3f,%.2f,%.3f\n", hostModeNames[mode], resonances[r] / 10,
+						f, measDb, measDeg, anaDb, anaDeg, dispDb + toDb(gain));
+			}
+
+			bool ok = maxErr <= tolerance;
+			if (!ok)
+				++failures;
+			printf("%-4s  %4d   %12.3f dB%s   %9.2f deg   %14.2f dB   %15.2f dB\n",
+				hostModeNames[mode], resonances[r] / 10, maxErr, ok ? "    " : " !!!",
+				maxPhase, maxDisp, sqrt(sumDisp / kNumPoints));
+		}
+	}
+
+	if (csv)
+	{
+		fclose(csv);
+		printf("\nWrote %s\n", csvPath);
+	}
+
+	if (failures)
+		printf("\n%d case(s) deviate from the analytic response by more than %.2f dB\n", failures, tolerance);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+#!/bin/sh
+#
+# Per-symbol code size and per-function stack usage of the plugin object,
+# checked against a budget.
+#
+# Lists every code symbol of the object (largest first, with compiler clones
+# such as .constprop/.isra and out-of-line copies of inline functions as
+# separate rows), the stack frame of every function from the -fstack-usage
+# .su files, and then compares each budget entry with the measured value.
+#
+# Budget file lines:
+#   code  <name>  <bytes>    total size of every code symbol whose demangled
+#                            name starts with <name> ("*" = all code)
+#   stack <name>  <bytes>    largest stack frame of a function whose name
+#                            starts with <name>
+# '#' starts a comment. A <name> ending in '(' matches one function and its
+# clones, e.g. "step(" but not "stepSomething(", and every instance of a
+# function template ("halfbandUpsample(" covers halfbandUpsample<Stage>).
+#
+# Usage:
+#   tools/sizecheck.sh [-w] <nm> <object> <budget> [file.su ...]
+#
+# Exits 1 if any entry is over budget or matches nothing (a symbol renamed
+# or removed has to be renamed or removed in the budget too). -w rewrites the
+# budget with the measured values plus SIZE_HEADROOM percent (default 10),
+# dropping entries that match nothing.
+
+set -e
+
+WRITE=0
+if [ "$1" = "-w" ]; then
+	WRITE=1
+	shift
+fi
+
+NM=$1
+OBJECT=$2
+BUDGET=$3
+if [ -z "$NM" ] || [ -z "$OBJECT" ] || [ -z "$BUDGET" ]; then
+	echo "usage: $0 [-w] <nm> <object> <budget> [file.su ...]" >&2
+	exit 1
+fi
+shift 3
+
+HEADROOM=${SIZE_HEADROOM:-10}
+TMP=${TMPDIR:-/tmp}/sizecheck.$$
+trap 'rm -f "$TMP".*' EXIT
+
+# "code <bytes> <name>" and "stack <bytes> <name>" records
+"$NM" -S -C --size-sort -t d "$OBJECT" | awk '
+	$3 ~ /^[tTwW]$/ {
+		size = $2 + 0
+		name = $0
+		sub(/^[^ ]+ [^ ]+ [^ ]+ /, "", name)
+		if (match(name, /^[^(<]* [A-Za-z_0-9:~]+</))
+			sub(/^[^(<]* /, "", name)       # drop the return type of a template
+		print "code\t" size "\t" name
+	}' > "$TMP.sym"
+for su in "$@"; do
+	[ -f "$su" ] || continue
+	awk -F '\t' '{
+		name = $1
+		sub(/^[^:]*:[0-9]+:[0-9]+:/, "", name)
+		if (match(name, /[A-Za-z_0-9:~]+\(/))
+			name = substr(name, RSTART)     # drop the return type
+		print "stack\t" $2 "\t" name
+	}' "$su"
+done > "$TMP.stack"
+
+echo ""
+echo "Code size by symbol (bytes):"
+sort -t "$(printf '\t')" -k2,2nr "$TMP.sym" | awk -F '\t' '{ printf "  %7d  %s\n", $2, $3 }'
+
+if [ -s "$TMP.stack" ]; then
+	echo ""
+	echo "Stack usage by function (bytes):"
+	sort -t "$(printf '\t')" -k2,2nr "$TMP.stack" | awk -F '\t' '{ printf "  %7d  %s\n", $2, $3 }'
+fi
+
+echo ""
+cat "$TMP.sym" "$TMP.stack" | awk -F '\t' -v budget="$BUDGET" -v write="$WRITE" -v headroom="$HEADROOM" '
+	# Template instances match their name: drop the (balanced) argument list
+	# after the function name, which may itself hold parentheses, e.g.
+	# svfBlock<(FilterMode)0> or adaaBlock<&(fastTanh(float)), ...>
+	function untemplate(s,    i, depth, c, end)
+	{
+		if (!match(s, /^[A-Za-z_0-9:~]+</))
+			return s
+		end = RLENGTH
+		depth = 1
+		for (i = end + 1; i <= length(s) && depth > 0; ++i)
+		{
+			c = substr(s, i, 1)
+			if (c == "<") ++depth
+			else if (c == ">") --depth
+		}
+		return substr(s, 1, end - 1) substr(s, i)
+	}
+	{
+		kind[NR] = $1; size[NR] = $2; name[NR] = untemplate($3); n = NR
+	}
+	END {
+		failed = 0
+		out = ""
+		printf "Budget (%s):\n", budget
+		while ((getline line < budget) > 0)
+		{
+			if (line ~ /^[ \t]*(#|$)/) { out = out line "\n"; continue }
+			split(line, f, /[ \t]+/)
+			k = f[1]; pat = f[2]; limit = f[3] + 0
+			measured = 0; matches = 0
+			for (i = 1; i <= n; ++i)
+			{
+				if (kind[i] != k)
+					continue
+				if (pat != "*" && index(name[i], pat) != 1)
+					continue
+				++matches
+				if (k == "code")
+					measured += size[i]
+				else if (size[i] + 0 > measured)
+					measured = size[i] + 0
+			}
+			if (write && matches == 0)
+			{
+				printf "  dropped %s %s: no matching symbol\n", k, pat
+				continue
+			}
+			if (write)
+			{
+				limit = int(measured * (100 + headroom) / 100 + 0.999)
+				out = out sprintf("%-6s %-24s %6d\n", k, pat, limit)
+				continue
+			}
+			status = "ok"
+			if (measured > limit)
+			{
+				status = "OVER"
+				failed = 1
+			}
+			note = ""
+			if (matches == 0)
+			{
+				status = "MISSING"
+				note = "  (no matching symbol)"
+				failed = 1
+			}
+			else if (matches > 1)
+				note = sprintf("  (%d symbols)", matches)
+			percent = (limit > 0) ? 100.0 * measured / limit : 0.0
+			printf "  %-5s %-24s %7d / %-7d %5.1f%%  %s%s\n", k, pat, measured, limit, percent, status, note
+		}
+		close(budget)
+		if (write)
+		{
+			printf "%s", out > budget
+			printf "  rewritten with %d%% headroom\n", headroom
+		}
+		exit failed
+	}'
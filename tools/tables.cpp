@@ -0,0 +1,243 @@
+/*
+tables - check of the generated constant tables
+
+The tables in tangents_tables.h are generated at build time by
+tools/gentables.cpp. This tool reads them back through the plugin's own
+lookups (prewarp, exp2Table, diodeClipTable and its antiderivative) and the
+halfband designs, and compares them against their reference functions in
+double precision and against the design specifications:
+
+  prewarp        relative error vs tan(pi r), r up to 0.45
+  exp2           relative error vs 2^x over ±10 octaves
+  diode curve    absolute error vs diodeClip's formula over ±20, and of the
+                 antiderivative inside the table
+  halfband FIR   stopband attenuation and passband ripple per stage
+  halfband IIR   stopband attenuation per stage
+
+Each check has the limit the source documents (halfbands less half a dB
+for its rounding); any check beyond it fails
+the run (exit status 1), so a change of the generator, the lookups or the
+compiler's float handling that degrades a table shows up here.
+
+Usage:
+  tables [-v]
+*/
+
+#include "host.h"
+
+#include <complex>
+#include <unistd.h>
+
+typedef std::complex<double> cdouble;
+
+static const double kPi = 3.14159265358979323846;
+static const int kSweep = 200000;
+
+// Halfband attenuations are documented rounded to the dB
+static const double kMarginDb = 0.5;
+
+static int failures = 0;
+
+/**
+ * Print one check and count it if over its limit
+ */
+static void report(const char* table, const char* check, double measured, double limit, bool atLeast = false)
+{
+	bool ok = atLeast ? measured >= limit : measured <= limit;
+	printf("%-14s %-32s %12.3g %12.3g  %s\n", table, check, measured, limit, ok ? "ok" : "FAIL");
+	if (!ok)
+		++failures;
+}
+
+/**
+ * Reference diode curve and antiderivative in double precision
+ */
+static double diodeReference(double x)
+{
+	return (x > 0.0) ? 1.0 - exp(-x) : -0.5 * (1.0 - exp(2.0 * x));
+}
+
+static double diodeAntiderivativeReference(double x)
+{
+	return (x > 0.0) ? x + expm1(-x) : -0.5 * x + 0.25 * expm1(2.0 * x);
+}
+
+/**
+ * Magnitude of a halfband FIR (odd taps only, centre 0.5) at f, relative
+ * to its higher rate
+ */
+static double firMagnitude(const float* coeffs, int numCoeffs, double f)
+{
+	double h = 0.5;
+	for (int i = 0; i < numCoeffs; ++i)
+		h += 2.0 * coeffs[i] * cos(2.0 * kPi * f * (2 * i + 1));
+	return fabs(h);
+}
+
+/**
+ * Magnitude of a polyphase IIR halfband, (A0(z^2) + z^-1 A1(z^2)) / 2, with
+ * coefficients alternating between the branches
+ */
+static double iirMagnitude(const float* coeffs, int numCoeffs, double f)
+{
+	cdouble z1 = std::polar(1.0, -2.0 * kPi * f);   // z^-1
+	cdouble z2 = z1 * z1;
+	cdouble a0 = 1.0, a1 = 1.0;
+	for (int i = 0; i < numCoeffs; ++i)
+	{
+		cdouble section = ((double)coeffs[i] + z2) / (1.0 + (double)coeffs[i] * z2);
+		if (i % 2 == 0)
+			a0 *= section;
+		else
+			a1 *= section;
+	}
+	return std::abs(0.5 * (a0 + z1 * a1));
+}
+
+/**
+ * Worst magnitude over [from, to] in dB, or the worst deviation from 1
+ */
+template <typename Magnitude>
+static double worstStopband(Magnitude magnitude, double from, double to)
+{
+	double worst = 0.0;
+	for (int i = 0; i <= kSweep / 10; ++i)
+	{
+		double m = magnitude(from + (to - from) * i / (kSweep / 10));
+		if (m > worst) worst = m;
+	}
+	return -20.0 * log10(worst);
+}
+
+template <typename Magnitude>
+static double worstRipple(Magnitude magnitude, double to)
+{
+	double worst = 0.0;
+	for (int i = 0; i <= kSweep / 10; ++i)
+	{
+		double d = fabs(magnitude(to * i / (kSweep / 10)) - 1.0);
+		if (d > worst) worst = d;
+	}
+	return worst;
+}
+
+struct FirResponse
+{
+	const float* coeffs;
+	int numCoeffs;
+	double operator()(double f) const { return firMagnitude(coeffs, numCoeffs, f); }
+};
+
+struct IirResponse
+{
+	const float* coeffs;
+	int numCoeffs;
+	double operator()(double f) const { return iirMagnitude(coeffs, numCoeffs, f); }
+};
+
+/**
+ * One halfband stage design and the figures tangents.cpp documents for it
+ */
+struct HalfbandSpec
+{
+	const char* name;
+	const float* coeffs;
+	int numCoeffs;
+	double pass;
+	double stop;
+	double attenuation;     // dB, as documented
+	double ripple;          // FIR passband, 0 = not checked
+};
+
+int main(int argc, char** argv)
+{
+	bool verbose = false;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "vh")) != -1)
+	{
+		switch (opt)
+		{
+			case 'v': verbose = true; break;
+			default:
+				fprintf(stderr, "usage: tables [-v]\n");
+				return 1;
+		}
+	}
+
+	printf("%-14s %-32s %12s %12s\n", "Table", "Check", "Measured", "Limit");
+
+	// Prewarp, relative to tan(pi r)
+	double worst = 0.0, worstAt = 0.0;
+	for (int i = 1; i <= kSweep; ++i)
+	{
+		float r = 0.45f * (float)i / (float)kSweep;
+		double ref = tan(kPi * (double)r);
+		double e = fabs((double)prewarp(r) - ref) / ref;
+		if (e > worst) { worst = e; worstAt = r; }
+	}
+	report("prewarp", "relative error, r <= 0.45", worst, 6.1e-6);
+	if (verbose) printf("%-14s   at r = %g\n", "", worstAt);
+
+	// exp2, relative to 2^x
+	worst = 0.0;
+	for (int i = 0; i <= kSweep; ++i)
+	{
+		float x = -10.0f + 20.0f * (float)i / (float)kSweep;
+		double ref = exp2((double)x);
+		double e = fabs((double)exp2Table(x) - ref) / ref;
+		if (e > worst) { worst = e; worstAt = x; }
+	}
+	report("exp2", "relative error, |x| <= 10", worst, 1.1e-6);
+	if (verbose) printf("%-14s   at x = %g\n", "", worstAt);
+
+	// Diode curve against the formula, inside the table and with the tails
+	double worstIn = 0.0, worstAll = 0.0, worstF = 0.0;
+	for (int i = 0; i <= 4 * kSweep; ++i)
+	{
+		float x = -20.0f + 40.0f * (float)i / (float)(4 * kSweep);
+		double e = fabs((double)diodeClipTable(x) - diodeReference(x));
+		if (e > worstAll) worstAll = e;
+		if (x < DIODE_TABLE_MIN || x > DIODE_TABLE_MAX)
+			continue;
+		if (e > worstIn) worstIn = e;
+		double eF = fabs((double)diodeClipTableAntiderivative(x) - diodeAntiderivativeReference(x));
+		if (eF > worstF) worstF = eF;
+	}
+	report("diode curve", "error inside [-6, 12]", worstIn, 4.6e-6);
+	report("diode curve", "error over [-20, 20]", worstAll, 6.2e-6);
+	report("diode curve", "antiderivative error in [-6, 12]", worstF, 2e-6);
+
+	// Halfband designs against the documented specifications
+	const HalfbandSpec firSpecs[] = {
+		{ "halfband FIR", halfbandCoeffs47, ARRAY_SIZE(halfbandCoeffs47), 0.20, 0.30, 72.0, 2.5e-4 },
+		{ "halfband FIR", halfbandCoeffs19, ARRAY_SIZE(halfbandCoeffs19), 0.10, 0.40, 83.0, 1e-4 },
+		{ "halfband FIR", halfbandCoeffs11, ARRAY_SIZE(halfbandCoeffs11), 0.05, 0.45, 70.0, 3.5e-4 },
+	};
+	const HalfbandSpec iirSpecs[] = {
+		{ "halfband IIR", halfbandIirCoeffs5, ARRAY_SIZE(halfbandIirCoeffs5), 0.20, 0.30, 87.0, 0.0 },
+		{ "halfband IIR", halfbandIirCoeffs2a, ARRAY_SIZE(halfbandIirCoeffs2a), 0.10, 0.40, 73.0, 0.0 },
+		{ "halfband IIR", halfbandIirCoeffs2b, ARRAY_SIZE(halfbandIirCoeffs2b), 0.05, 0.45, 104.0, 0.0 },
+	};
+
+	char check[64];
+	for (size_t s = 0; s < ARRAY_SIZE(firSpecs); ++s)
+	{
+		const HalfbandSpec& spec = firSpecs[s];
+		FirResponse response = { spec.coeffs, spec.numCoeffs };
+		sprintf(check, "%d taps, stop dB from %.2f", 4 * spec.numCoeffs - 1, spec.stop);
+		report(spec.name, check, worstStopband(response, spec.stop, 0.5), spec.attenuation - kMarginDb, true);
+		sprintf(check, "%d taps, ripple up to %.2f", 4 * spec.numCoeffs - 1, spec.pass);
+		report(spec.name, check, worstRipple(response, spec.pass), spec.ripple);
+	}
+	for (size_t s = 0; s < ARRAY_SIZE(iirSpecs); ++s)
+	{
+		const HalfbandSpec& spec = iirSpecs[s];
+		IirResponse response = { spec.coeffs, spec.numCoeffs };
+		sprintf(check, "%d sections, stop dB from %.2f", spec.numCoeffs, spec.stop);
+		report(spec.name, check, worstStopband(response, spec.stop, 0.5), spec.attenuation - kMarginDb, true);
+	}
+
+	printf("\n%s\n", failures ? "FAILED" : "All tables within their limits");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+/*
+Minimal mono audio file I/O for the host tools
+
+Reads RIFF/WAVE (PCM 16/24/32-bit and IEEE float, first channel only) and
+headerless raw native-endian float32 ("*.f32" / "*.raw"). Writes float32 WAV
+or raw float32 depending on the file extension.
+*/
+
+#ifndef TANGENTS_WAV_H
+#define TANGENTS_WAV_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+inline bool wavIsRaw(const char* path)
+{
+	const char* dot = strrchr(path, '.');
+	return dot && (strcmp(dot, ".f32") == 0 || strcmp(dot, ".raw") == 0);
+}
+
+inline uint32_t wavLE(const uint8_t* p, int bytes)
+{
+	uint32_t value = 0;
+	for (int i = bytes - 1; i >= 0; --i)
+		value = (value << 8) | p[i];
+	return value;
+}
+
+/**
+ * Load a mono signal. sampleRate is left untouched for raw files.
+ * Returns false (with a message on stderr) if the file can't be used.
+ */
+inline bool wavRead(const char* path, std::vector<float>& samples, uint32_t& sampleRate)
+{
+	FILE* f = fopen(path, "rb");
+	if (!f)
+	{
+		fprintf(stderr, "Can't open %s\n", path);
+		return false;
+	}
+
+	std::vector<uint8_t> data;
+	uint8_t chunk[65536];
+	size_t n;
+	while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+		data.insert(data.end(), chunk, chunk + n);
+	fclose(f);
+
+	samples.clear();
+
+	if (wavIsRaw(path))
+	{
+		samples.resize(data.size() / sizeof(float));
+		if (!samples.empty())
+			memcpy(&samples[0], &data[0], samples.size() * sizeof(float));
+		return true;
+	}
+
+	if (data.size() < 12 || memcmp(&data[0], "RIFF", 4) != 0 || memcmp(&data[8], "WAVE", 4) != 0)
+	{
+		fprintf(stderr, "%s is not a WAV file\n", path);
+		return false;
+	}
+
+	int format = 0, channels = 0, bits = 0;
+	size_t pos = 12;
+	while (pos + 8 <= data.size())
+	{
+		const uint8_t* p = &data[pos];
+		size_t size = wavLE(p + 4, 4);
+		const uint8_t* body = p + 8;
+		if (pos + 8 + size > data.size())
+			size = data.size() - pos - 8;
+
+		if (memcmp(p, "fmt ", 4) == 0 && size >= 16)
+		{
+			format = wavLE(body, 2);
+			channels = wavLE(body + 2, 2);
+			sampleRate = wavLE(body + 4, 4);
+			bits = wavLE(body + 14, 2);
+			if (format == 0xFFFE && size >= 26)
+				format = wavLE(body + 24, 2);  // WAVE_FORMAT_EXTENSIBLE subformat
+		}
+		else if (memcmp(p, "data", 4) == 0 && channels > 0)
+		{
+			int bytes = bits / 8;
+			size_t frames = size / (bytes * channels);
+			samples.resize(frames);
+			for (size_t i = 0; i < frames; ++i)
+			{
+				const uint8_t* s = body + i * bytes * channels;
+				if (format == 3 && bits == 32)
+				{
+					memcpy(&samples[i], s, sizeof(float));
+				}
+				else if (format == 1 && bytes >= 2 && bytes <= 4)
+				{
+					int32_t value = (int32_t)(wavLE(s, bytes) << (32 - bits));
+					samples[i] = value / 2147483648.0f;
+				}
+				else
+				{
+					fprintf(stderr, "%s: unsupported WAV format %d/%d-bit\n", path, format, bits);
+					return false;
+				}
+			}
+			return true;
+		}
+
+		pos += 8 + size + (size & 1);
+	}
+
+	fprintf(stderr, "%s has no audio data\n", path);
+	return false;
+}
+
+inline void wavPut(std::vector<uint8_t>& out, uint32_t value, int bytes)
+{
+	for (int i = 0; i < bytes; ++i)
+		out.push_back((value >> (8 * i)) & 0xFF);
+}
+
+/**
+ * Write a mono float32 WAV, or raw float32 if the extension asks for it
+ */
+inline bool wavWrite(const char* path, const float* samples, size_t length, uint32_t sampleRate)
+{
+	FILE* f = fopen(path, "wb");
+	if (!f)
+	{
+		fprintf(stderr, "Can't create %s\n", path);
+		return false;
+	}
+
+	if (!wavIsRaw(path))
+	{
+		uint32_t dataBytes = (uint32_t)(length * sizeof(float));
+		std::vector<uint8_t> header;
+		header.insert(header.end(), "RIFF", "RIFF" + 4);
+		wavPut(header, 36 + dataBytes, 4);
+		header.insert(header.end(), "WAVE", "WAVE" + 4);
+		header.insert(header.end(), "fmt ", "fmt " + 4);
+		wavPut(header, 16, 4);
+		wavPut(header, 3, 2);                    // IEEE float
+		wavPut(header, 1, 2);                    // mono
+		wavPut(header, sampleRate, 4);
+		wavPut(header, sampleRate * 4, 4);       // byte rate
+		wavPut(header, 4, 2);                    // block align
+		wavPut(header, 32, 2);                   // bits per sample
+		header.insert(header.end(), "data", "data" + 4);
+		wavPut(header, dataBytes, 4);
+		fwrite(&header[0], 1, header.size(), f);
+	}
+
+	bool ok = fwrite(samples, sizeof(float), length, f) == length;
+	fclose(f);
+	return ok;
+}
+
+#endif // TANGENTS_WAV_H
@@ -0,0 +1,417 @@
+/*
+wcet - worst-case execution time search for step()
+
+Searches the parameter space (Cutoff, Resonance, Model, Mode, Oversample,
+Resampler, Anti-alias, Multirate, Saturator, Drive, Input AGR, CV amounts) together with
+adversarial input and CV signals for the settings that make step() slowest
+per block. A random sweep seeds the search, then the slowest candidates are
+hill-climbed one dimension at a time.
+
+A case's cost is the median time per block over a run of blocks after the
+parameter smoothing has settled, so it reflects the data-dependent cost of
+the configuration rather than scheduler noise. The worst cases found are
+written as one line of key=value pairs each; feeding that file back with -r
+re-measures exactly the same settings and signals.
+
+Usage:
+  wcet [-n randomCases] [-c climbSteps] [-k keep] [-b blockFrames] [-s seed] [-o out.txt]
+  wcet -r cases.txt [-b blockFrames]
+*/
+
+#include "host.h"
+
+#include <unistd.h>
+#include <algorithm>
+
+static const int kWarmupBlocks = 48;
+static const int kMeasureBlocks = 64;
+
+// ============================================================================
+// SEARCH SPACE
+// ============================================================================
+
+enum
+{
+	kSignalSilence,
+	kSignalNoise,
+	kSignalNyquist,     // alternating +A/-A, maximum slew every sample
+	kSignalSquare,      // low-frequency square, long saturated plateaus
+	kSignalDC,
+	kSignalDenormal,    // noise in the subnormal range
+	kSignalSweep,
+	kNumSignals
+};
+
+static const char* const signalNames[] = {
+	"silence", "noise", "nyquist", "square", "dc", "denormal", "sweep"
+};
+
+enum
+{
+	kCvNone,
+	kCvDC,
+	kCvNoise,
+	kCvRamp,
+	kNumCv
+};
+
+static const char* const cvNames[] = { "none", "dc", "noise", "ramp" };
+
+/**
+ * One searchable dimension. Dimensions with a parameter index take their
+ * range from the plugin's own parameter table; the signal dimensions close
+ * the list.
+ */
+struct WcetDim
+{
+	const char* name;
+	int param;
+	int min;
+	int max;
+};
+
+static WcetDim dims[] = {
+	{ "cutoff",     kParamCutoff,         0, 0 },
+	{ "resonance",  kParamResonance,      0, 0 },
+	{ "model",      kParamModel,          0, 0 },
+	{ "mode",       kParamMode,           0, 0 },
+	{ "oversample", kParamOversample,     0, 0 },
+	{ "resampler",  kParamResampler,      0, 0 },
+	{ "antialias",  kParamAntialias,      0, 0 },
+	{ "multirate",  kParamMultirate,      0, 0 },
+	{ "saturator",  kParamSaturator,      0, 0 },
+	{ "drive",      kParamDrive,          0, 0 },
+	{ "agr",        kParamInputAGR,       0, 0 },
+	{ "cvCutAmt",   kParamCvCutoffAmt,    0, 0 },
+	{ "cvResAmt",   kParamCvResonanceAmt, 0, 0 },
+	{ "signal",     -1, 0, kNumSignals - 1 },
+	{ "cv",         -1, 0, kNumCv - 1 },
+	{ "level",      -1, 0, 1000 },           // input / CV amplitude, 0-10.00
+};
+
+static const int kNumDims = ARRAY_SIZE(dims);
+static const int kDimSignal = kNumDims - 3;
+static const int kDimCv = kNumDims - 2;
+static const int kDimLevel = kNumDims - 1;
+
+struct WcetCase
+{
+	int value[kNumDims];
+	uint32_t seed;
+	double cost;     // median ns per block
+	double worst;    // slowest single block seen, ns
+};
+
+static bool wcetSlower(const WcetCase& a, const WcetCase& b)
+{
+	return a.cost > b.cost;
+}
+
+// ============================================================================
+// SIGNALS
+// ============================================================================
+
+static void wcetSignal(int type, float level, uint32_t seed, float* dst, int n)
+{
+	uint32_t state = seed ? seed : 1;
+	for (int i = 0; i < n; ++i)
+	{
+		float x;
+		switch (type)
+		{
+			case kSignalNoise:    x = level * (2.0f * fastRandom(state) - 1.0f); break;
+			case kSignalNyquist:  x = (i & 1) ? level : -level; break;
+			case kSignalSquare:   x = ((i / 480) & 1) ? level : -level; break;
+			case kSignalDC:       x = level; break;
+			case kSignalDenormal: x = 1e-39f * (2.0f * fastRandom(state) - 1.0f); break;
+			case kSignalSweep:    x = level * sinf(0.5f * (float)i * (float)i / (float)n); break;
+			default:              x = 0.0f;
+		}
+		dst[i] = x;
+	}
+}
+
+static void wcetCv(int type, float level, uint32_t seed, float* dst, int n)
+{
+	uint32_t state = seed ^ 0x9E3779B9;
+	for (int i = 0; i < n; ++i)
+	{
+		switch (type)
+		{
+			case kCvDC:    dst[i] = level; break;
+			case kCvNoise: dst[i] = level * (2.0f * fastRandom(state) - 1.0f); break;
+			case kCvRamp:  dst[i] = level * (2.0f * (float)i / (float)n - 1.0f); break;
+			default:       dst[i] = 0.0f;
+		}
+	}
+}
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+static void wcetMeasure(WcetCase& c, int blockFrames)
+{
+	const int total = (kWarmupBlocks + kMeasureBlocks) * blockFrames;
+	std::vector<float> input(total), cv(total);
+	float level = c.value[kDimLevel] / 100.0f;
+	wcetSignal(c.value[kDimSignal], level, c.seed, &input[0], total);
+	wcetCv(c.value[kDimCv], level, c.seed, &cv[0], total);
+
+	HostPlugin plugin;
+	plugin.create();
+	plugin.set(kParamInput, 1);
+	plugin.set(kParamOutputMode, 1);
+	for (int d = 0; d < kNumDims; ++d)
+		if (dims[d].param >= 0)
+			plugin.set(dims[d].param, c.value[d]);
+	if (c.value[kDimCv] != kCvNone)
+	{
+		plugin.set(kParamCvCutoff, 2);
+		plugin.set(kParamCvResonance, 3);
+	}
+
+	std::vector<double> times;
+	for (int b = 0; b < kWarmupBlocks + kMeasureBlocks; ++b)
+	{
+		int pos = b * blockFrames;
+		memcpy(plugin.bus(1, blockFrames), &input[pos], blockFrames * sizeof(float));
+		memcpy(plugin.bus(2, blockFrames), &cv[pos], blockFrames * sizeof(float));
+		memcpy(plugin.bus(3, blockFrames), &cv[pos], blockFrames * sizeof(float));
+
+		double start = hostSeconds();
+		plugin.step(blockFrames);
+		double elapsed = hostSeconds() - start;
+
+		if (b >= kWarmupBlocks)
+			times.push_back(elapsed * 1e9);
+	}
+
+	std::sort(times.begin(), times.end());
+	c.cost = times[times.size() / 2];
+	c.worst = times.back();
+}
+
+// ============================================================================
+// TEST VECTOR I/O
+// ============================================================================
+
+static void wcetPrint(FILE* f, const WcetCase& c)
+{
+	for (int d = 0; d < kNumDims; ++d)
+	{
+		if (d == kDimSignal)
+			fprintf(f, "signal=%s ", signalNames[c.value[d]]);
+		else if (d == kDimCv)
+			fprintf(f, "cv=%s ", cvNames[c.value[d]]);
+		else
+			fprintf(f, "%s=%d ", dims[d].name, c.value[d]);
+	}
+	fprintf(f, "seed=%u ns_per_block=%.0f worst_ns=%.0f\n", c.seed, c.cost, c.worst);
+}
+
+static bool wcetParse(char* line, WcetCase& c)
+{
+	memset(&c, 0, sizeof(c));
+	int found = 0;
+	for (char* tok = strtok(line, " \t\r\n"); tok; tok = strtok(NULL, " \t\r\n"))
+	{
+		char* eq = strchr(tok, '=');
+		if (!eq)
+			continue;
+		*eq = 0;
+		const char* val = eq + 1;
+
+		if (strcmp(tok, "seed") == 0)
+		{
+			c.seed = (uint32_t)strtoul(val, NULL, 10);
+			continue;
+		}
+		for (int d = 0; d < kNumDims; ++d)
+		{
+			if (strcmp(tok, dims[d].name) != 0)
+				continue;
+			if (d == kDimSignal || d == kDimCv)
+			{
+				const char* const* names = (d == kDimSignal) ? signalNames : cvNames;
+				for (int k = 0; k <= dims[d].max; ++k)
+					if (strcmp(val, names[k]) == 0)
+						c.value[d] = k;
+			}
+			else
+			{
+				c.value[d] = atoi(val);
+			}
+			++found;
+		}
+	}
+	return found == kNumDims;
+}
+
+// ============================================================================
+// SEARCH
+// ============================================================================
+
+static int wcetRandomValue(int d, uint32_t& rng)
+{
+	int span = dims[d].max - dims[d].min + 1;
+	return dims[d].min + (int)(fastRandom(rng) * (span - 1) + 0.5f);
+}
+
+static void wcetRandomCase(WcetCase& c, uint32_t& rng)
+{
+	for (int d = 0; d < kNumDims; ++d)
+		c.value[d] = wcetRandomValue(d, rng);
+	c.seed = (uint32_t)(fastRandom(rng) * 0x7FFFFFFF) | 1;
+}
+
+/**
+ * Move one dimension: enums jump to any value, continuous dimensions take a
+ * step of up to 20% of their range or, now and then, jump to an extreme
+ */
+static void wcetPerturb(WcetCase& c, uint32_t& rng)
+{
+	int d = (int)(fastRandom(rng) * (kNumDims - 1) + 0.5f);
+	int span = dims[d].max - dims[d].min;
+	float r = fastRandom(rng);
+
+	if (span <= 8)
+		c.value[d] = wcetRandomValue(d, rng);
+	else if (r < 0.1f)
+		c.value[d] = dims[d].min;
+	else if (r < 0.2f)
+		c.value[d] = dims[d].max;
+	else
+	{
+		int v = c.value[d] + (int)((2.0f * fastRandom(rng) - 1.0f) * 0.2f * span);
+		if (v < dims[d].min) v = dims[d].min;
+		if (v > dims[d].max) v = dims[d].max;
+		c.value[d] = v;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int randomCases = 300;
+	int climbSteps = 60;
+	int keep = 8;
+	int blockFrames = kHostDefaultBlockFrames;
+	uint32_t seed = 1;
+	const char* outPath = "build/tools/wcet_cases.txt";
+	const char* replayPath = NULL;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "n:c:k:b:s:o:r:h")) != -1)
+	{
+		switch (opt)
+		{
+			case 'n': randomCases = atoi(optarg); break;
+			case 'c': climbSteps = atoi(optarg); break;
+			case 'k': keep = atoi(optarg); break;
+			case 'b': blockFrames = atoi(optarg); break;
+			case 's': seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+			case 'o': outPath = optarg; break;
+			case 'r': replayPath = optarg; break;
+			default:
+				fprintf(stderr, "usage: wcet [-n randomCases] [-c climbSteps] [-k keep] [-b blockFrames] [-s seed] [-o out]\n"
+				                "       wcet -r cases.txt [-b blockFrames]\n");
+				return 1;
+		}
+	}
+
+	if (blockFrames < 4 || (blockFrames & 3) || keep < 1 || randomCases < keep)
+	{
+		fprintf(stderr, "Block size must be a multiple of 4; need at least as many random cases as kept\n");
+		return 1;
+	}
+
+	NT_globals.maxFramesPerStep = blockFrames;
+	for (int d = 0; d < kNumDims; ++d)
+	{
+		if (dims[d].param >= 0)
+		{
+			dims[d].min = parameters[dims[d].param].min;
+			dims[d].max = parameters[dims[d].param].max;
+		}
+	}
+
+	double deadline = 1e9 * blockFrames / NT_globals.sampleRate;
+
+	if (replayPath)
+	{
+		FILE* f = fopen(replayPath, "r");
+		if (!f)
+		{
+			fprintf(stderr, "Can't open %s\n", replayPath);
+			return 1;
+		}
+		char line[1024];
+		while (fgets(line, sizeof(line), f))
+		{
+			WcetCase c;
+			if (line[0] == '#' || !wcetParse(line, c))
+				continue;
+			wcetMeasure(c, blockFrames);
+			printf("%6.2f%%  ", 100.0 * c.cost / deadline);
+			wcetPrint(stdout, c);
+		}
+		fclose(f);
+		return 0;
+	}
+
+	uint32_t rng = seed;
+	std::vector<WcetCase> cases(randomCases);
+
+	printf("Random sweep: %d cases, %d-frame blocks (deadline %.0f ns)\n", randomCases, blockFrames, deadline);
+	for (int i = 0; i < randomCases; ++i)
+	{
+		wcetRandomCase(cases[i], rng);
+		wcetMeasure(cases[i], blockFrames);
+	}
+	std::sort(cases.begin(), cases.end(), wcetSlower);
+	cases.resize(keep);
+
+	printf("Hill climbing the %d slowest, %d steps each\n", keep, climbSteps);
+	for (int k = 0; k < keep; ++k)
+	{
+		for (int step = 0; step < climbSteps; ++step)
+		{
+			WcetCase candidate = cases[k];
+			wcetPerturb(candidate, rng);
+			wcetMeasure(candidate, blockFrames);
+			if (candidate.cost > cases[k].cost)
+				cases[k] = candidate;
+		}
+	}
+
+	// Re-measure the survivors so the reported figures aren't lucky outliers
+	for (int k = 0; k < keep; ++k)
+	{
+		WcetCase again = cases[k];
+		wcetMeasure(again, blockFrames);
+		if (again.cost < cases[k].cost)
+			cases[k].cost = again.cost;
+	}
+	std::sort(cases.begin(), cases.end(), wcetSlower);
+
+	FILE* out = fopen(outPath, "w");
+	if (!out)
+	{
+		fprintf(stderr, "Can't create %s\n", outPath);
+		return 1;
+	}
+	fprintf(out, "# wcet worst cases, %d-frame blocks @ %u Hz; replay with: wcet -r <this file>\n",
+	        blockFrames, NT_globals.sampleRate);
+
+	printf("\n  %% of block deadline\n");
+	for (int k = 0; k < keep; ++k)
+	{
+		printf("%6.2f%%  ", 100.0 * cases[k].cost / deadline);
+		wcetPrint(stdout, cases[k]);
+		wcetPrint(out, cases[k]);
+	}
+	fclose(out);
+	printf("\nWrote %s\n", outPath);
+
+	return 0;
+}